@@ -6,20 +6,409 @@
 
 using namespace Rcpp;
 
+// ca_sparse_cppl
+List ca_sparse_cppl(const IntegerVector& slot_i, const IntegerVector& slot_p, const NumericVector& slot_x, const int N, const int K, const int nd, const double smooth, const double tol, const int max_iter, const int thread);
+RcppExport SEXP quanteda_ca_sparse_cppl(SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP NSEXP, SEXP KSEXP, SEXP ndSEXP, SEXP smoothSEXP, SEXP tolSEXP, SEXP max_iterSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const int >::type N(NSEXP);
+    Rcpp::traits::input_parameter< const int >::type K(KSEXP);
+    Rcpp::traits::input_parameter< const int >::type nd(ndSEXP);
+    Rcpp::traits::input_parameter< const double >::type smooth(smoothSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< const int >::type max_iter(max_iterSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(ca_sparse_cppl(slot_i, slot_p, slot_x, N, K, nd, smooth, tol, max_iter, thread));
+    return __result;
+END_RCPP
+}
+// collocations_hashed_cppl
+List collocations_hashed_cppl(List texts, const std::vector<int>& puncts, const int size, const bool span_punct, const int min_count, const int thread);
+RcppExport SEXP quanteda_collocations_hashed_cppl(SEXP textsSEXP, SEXP punctsSEXP, SEXP sizeSEXP, SEXP span_punctSEXP, SEXP min_countSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type puncts(punctsSEXP);
+    Rcpp::traits::input_parameter< const int >::type size(sizeSEXP);
+    Rcpp::traits::input_parameter< const bool >::type span_punct(span_punctSEXP);
+    Rcpp::traits::input_parameter< const int >::type min_count(min_countSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(collocations_hashed_cppl(texts, puncts, size, span_punct, min_count, thread));
+    return __result;
+END_RCPP
+}
+// dfm_hashed_cppl
+List dfm_hashed_cppl(List texts, const int n_types, const int thread);
+RcppExport SEXP quanteda_dfm_hashed_cppl(SEXP textsSEXP, SEXP n_typesSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_types(n_typesSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(dfm_hashed_cppl(texts, n_types, thread));
+    return __result;
+END_RCPP
+}
+// dfm_builder_new_cpp
+SEXP dfm_builder_new_cpp();
+RcppExport SEXP quanteda_dfm_builder_new_cpp() {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    __result = Rcpp::wrap(dfm_builder_new_cpp());
+    return __result;
+END_RCPP
+}
+// dfm_builder_add_tokens_cppl
+void dfm_builder_add_tokens_cppl(SEXP builder_, List texts, const std::vector<std::string>& types, const std::vector<std::string>& docnames, const int thread);
+RcppExport SEXP quanteda_dfm_builder_add_tokens_cppl(SEXP builder_SEXP, SEXP textsSEXP, SEXP typesSEXP, SEXP docnamesSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type builder_(builder_SEXP);
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type docnames(docnamesSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    dfm_builder_add_tokens_cppl(builder_, texts, types, docnames, thread);
+    return R_NilValue;
+END_RCPP
+}
+// dfm_builder_add_dfm_cpp
+void dfm_builder_add_dfm_cpp(SEXP builder_, const std::vector<int>& slot_i, const std::vector<int>& slot_p, const std::vector<double>& slot_x, const std::vector<std::string>& features, const std::vector<std::string>& docnames);
+RcppExport SEXP quanteda_dfm_builder_add_dfm_cpp(SEXP builder_SEXP, SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP featuresSEXP, SEXP docnamesSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type builder_(builder_SEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type features(featuresSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type docnames(docnamesSEXP);
+    dfm_builder_add_dfm_cpp(builder_, slot_i, slot_p, slot_x, features, docnames);
+    return R_NilValue;
+END_RCPP
+}
+// dfm_builder_info_cpp
+List dfm_builder_info_cpp(SEXP builder_);
+RcppExport SEXP quanteda_dfm_builder_info_cpp(SEXP builder_SEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type builder_(builder_SEXP);
+    __result = Rcpp::wrap(dfm_builder_info_cpp(builder_));
+    return __result;
+END_RCPP
+}
+// dfm_builder_slots_cpp
+List dfm_builder_slots_cpp(SEXP builder_);
+RcppExport SEXP quanteda_dfm_builder_slots_cpp(SEXP builder_SEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type builder_(builder_SEXP);
+    __result = Rcpp::wrap(dfm_builder_slots_cpp(builder_));
+    return __result;
+END_RCPP
+}
+// dfm_dictionary_hashed_cppl
+List dfm_dictionary_hashed_cppl(List texts, const int n_types, const List& values, const std::vector<int>& keys, const int n_keys, const bool exclusive, const int thread);
+RcppExport SEXP quanteda_dfm_dictionary_hashed_cppl(SEXP textsSEXP, SEXP n_typesSEXP, SEXP valuesSEXP, SEXP keysSEXP, SEXP n_keysSEXP, SEXP exclusiveSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_types(n_typesSEXP);
+    Rcpp::traits::input_parameter< const List& >::type values(valuesSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type keys(keysSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_keys(n_keysSEXP);
+    Rcpp::traits::input_parameter< const bool >::type exclusive(exclusiveSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(dfm_dictionary_hashed_cppl(texts, n_types, values, keys, n_keys, exclusive, thread));
+    return __result;
+END_RCPP
+}
+// duplicates_hashed_cppl
+List duplicates_hashed_cppl(List texts, const int size, const int n_hashes, const int n_bands, const double threshold, const bool verify, const int seed, const int thread);
+RcppExport SEXP quanteda_duplicates_hashed_cppl(SEXP textsSEXP, SEXP sizeSEXP, SEXP n_hashesSEXP, SEXP n_bandsSEXP, SEXP thresholdSEXP, SEXP verifySEXP, SEXP seedSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const int >::type size(sizeSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_hashes(n_hashesSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_bands(n_bandsSEXP);
+    Rcpp::traits::input_parameter< const double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< const bool >::type verify(verifySEXP);
+    Rcpp::traits::input_parameter< const int >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(duplicates_hashed_cppl(texts, size, n_hashes, n_bands, threshold, verify, seed, thread));
+    return __result;
+END_RCPP
+}
+// duplicates_dfm_cppl
+List duplicates_dfm_cppl(const NumericVector& slot_x, const IntegerVector& slot_i, const IntegerVector& slot_p, const int n_docs, const int n_hashes, const int n_bands, const double threshold, const bool verify, const int seed, const int thread);
+RcppExport SEXP quanteda_duplicates_dfm_cppl(SEXP slot_xSEXP, SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP n_docsSEXP, SEXP n_hashesSEXP, SEXP n_bandsSEXP, SEXP thresholdSEXP, SEXP verifySEXP, SEXP seedSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_docs(n_docsSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_hashes(n_hashesSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_bands(n_bandsSEXP);
+    Rcpp::traits::input_parameter< const double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< const bool >::type verify(verifySEXP);
+    Rcpp::traits::input_parameter< const int >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(duplicates_dfm_cppl(slot_x, slot_i, slot_p, n_docs, n_hashes, n_bands, threshold, verify, seed, thread));
+    return __result;
+END_RCPP
+}
+// dfm_feature_hashed_cppl
+List dfm_feature_hashed_cppl(List texts, const std::vector<std::string>& types, const std::vector<int>& ns, const std::vector<int>& ks, const int bits, const bool is_signed, const int n_sample, const std::string& delim, const int thread);
+RcppExport SEXP quanteda_dfm_feature_hashed_cppl(SEXP textsSEXP, SEXP typesSEXP, SEXP nsSEXP, SEXP ksSEXP, SEXP bitsSEXP, SEXP is_signedSEXP, SEXP n_sampleSEXP, SEXP delimSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ns(nsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ks(ksSEXP);
+    Rcpp::traits::input_parameter< const int >::type bits(bitsSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_signed(is_signedSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_sample(n_sampleSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type delim(delimSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(dfm_feature_hashed_cppl(texts, types, ns, ks, bits, is_signed, n_sample, delim, thread));
+    return __result;
+END_RCPP
+}
+// write_tokens_cpp
+void write_tokens_cpp(List texts, const CharacterVector& types_, const CharacterVector& docnames_, const CharacterVector& meta_, const std::string& path, const bool append);
+RcppExport SEXP quanteda_write_tokens_cpp(SEXP textsSEXP, SEXP types_SEXP, SEXP docnames_SEXP, SEXP meta_SEXP, SEXP pathSEXP, SEXP appendSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type types_(types_SEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type docnames_(docnames_SEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type meta_(meta_SEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const bool >::type append(appendSEXP);
+    write_tokens_cpp(texts, types_, docnames_, meta_, path, append);
+    return R_NilValue;
+END_RCPP
+}
+// read_tokens_index_cpp
+List read_tokens_index_cpp(const std::string& path);
+RcppExport SEXP quanteda_read_tokens_index_cpp(SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    __result = Rcpp::wrap(read_tokens_index_cpp(path));
+    return __result;
+END_RCPP
+}
+// read_tokens_cpp
+List read_tokens_cpp(const std::string& path, const std::vector<int>& docs);
+RcppExport SEXP quanteda_read_tokens_cpp(SEXP pathSEXP, SEXP docsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type docs(docsSEXP);
+    __result = Rcpp::wrap(read_tokens_cpp(path, docs));
+    return __result;
+END_RCPP
+}
+// dfm_tokens_file_cppl
+List dfm_tokens_file_cppl(const std::string& path, const std::vector<int>& ids_new, const int n_new, const int thread);
+RcppExport SEXP quanteda_dfm_tokens_file_cppl(SEXP pathSEXP, SEXP ids_newSEXP, SEXP n_newSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ids_new(ids_newSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_new(n_newSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(dfm_tokens_file_cppl(path, ids_new, n_new, thread));
+    return __result;
+END_RCPP
+}
+// write_dfm_cpp
+void write_dfm_cpp(const IntegerVector& slot_i, const IntegerVector& slot_p, const NumericVector& slot_x, const int n_rows, const int n_cols, const CharacterVector& docnames, const CharacterVector& features, const std::string& path);
+RcppExport SEXP quanteda_write_dfm_cpp(SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP n_rowsSEXP, SEXP n_colsSEXP, SEXP docnamesSEXP, SEXP featuresSEXP, SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_rows(n_rowsSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_cols(n_colsSEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type docnames(docnamesSEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type features(featuresSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    write_dfm_cpp(slot_i, slot_p, slot_x, n_rows, n_cols, docnames, features, path);
+    return R_NilValue;
+END_RCPP
+}
+// read_dfm_index_cpp
+List read_dfm_index_cpp(const std::string& path);
+RcppExport SEXP quanteda_read_dfm_index_cpp(SEXP pathSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    __result = Rcpp::wrap(read_dfm_index_cpp(path));
+    return __result;
+END_RCPP
+}
+// read_dfm_cpp
+List read_dfm_cpp(const std::string& path, const std::vector<int>& cols);
+RcppExport SEXP quanteda_read_dfm_cpp(SEXP pathSEXP, SEXP colsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::string& >::type path(pathSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type cols(colsSEXP);
+    __result = Rcpp::wrap(read_dfm_cpp(path, cols));
+    return __result;
+END_RCPP
+}
+// kwic_hashed_cppl
+List kwic_hashed_cppl(List texts, const std::vector<std::string>& types, const List& keywords, const int window, const int thread);
+RcppExport SEXP quanteda_kwic_hashed_cppl(SEXP textsSEXP, SEXP typesSEXP, SEXP keywordsSEXP, SEXP windowSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const List& >::type keywords(keywordsSEXP);
+    Rcpp::traits::input_parameter< const int >::type window(windowSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(kwic_hashed_cppl(texts, types, keywords, window, thread));
+    return __result;
+END_RCPP
+}
+// nb_train_cppl
+NumericMatrix nb_train_cppl(const std::vector<int>& slot_i, const std::vector<int>& slot_p, const std::vector<double>& slot_x, const std::vector<int>& classes, const int n_classes, const bool bernoulli, const int thread);
+RcppExport SEXP quanteda_nb_train_cppl(SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP classesSEXP, SEXP n_classesSEXP, SEXP bernoulliSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type classes(classesSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_classes(n_classesSEXP);
+    Rcpp::traits::input_parameter< const bool >::type bernoulli(bernoulliSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(nb_train_cppl(slot_i, slot_p, slot_x, classes, n_classes, bernoulli, thread));
+    return __result;
+END_RCPP
+}
+// nb_predict_cppl
+List nb_predict_cppl(const std::vector<int>& slot_i, const std::vector<int>& slot_p, const std::vector<double>& slot_x, const int n_docs, const std::vector<int>& features, const NumericMatrix& log_lik, const std::vector<double>& log_prior, const bool bernoulli, const int thread);
+RcppExport SEXP quanteda_nb_predict_cppl(SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP n_docsSEXP, SEXP featuresSEXP, SEXP log_likSEXP, SEXP log_priorSEXP, SEXP bernoulliSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_docs(n_docsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type features(featuresSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type log_lik(log_likSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type log_prior(log_priorSEXP);
+    Rcpp::traits::input_parameter< const bool >::type bernoulli(bernoulliSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(nb_predict_cppl(slot_i, slot_p, slot_x, n_docs, features, log_lik, log_prior, bernoulli, thread));
+    return __result;
+END_RCPP
+}
 // skipgramcpp
-StringVector skipgramcpp(std::vector < std::string > tokens, std::vector < int > ns, std::vector < int > ks, std::string delim);
+StringVector skipgramcpp(const CharacterVector& tokens, const std::vector<int>& ns, const std::vector<int>& ks, const std::string& delim);
 RcppExport SEXP quanteda_skipgramcpp(SEXP tokensSEXP, SEXP nsSEXP, SEXP ksSEXP, SEXP delimSEXP) {
 BEGIN_RCPP
     Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< std::vector < std::string > >::type tokens(tokensSEXP);
-    Rcpp::traits::input_parameter< std::vector < int > >::type ns(nsSEXP);
-    Rcpp::traits::input_parameter< std::vector < int > >::type ks(ksSEXP);
-    Rcpp::traits::input_parameter< std::string >::type delim(delimSEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type tokens(tokensSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ns(nsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ks(ksSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type delim(delimSEXP);
     __result = Rcpp::wrap(skipgramcpp(tokens, ns, ks, delim));
     return __result;
 END_RCPP
 }
+// skipgram_hashed_cppl
+List skipgram_hashed_cppl(List texts, const std::vector<std::string>& types, const std::vector<int>& ns, const std::vector<int>& ks, const std::string& delim);
+RcppExport SEXP quanteda_skipgram_hashed_cppl(SEXP textsSEXP, SEXP typesSEXP, SEXP nsSEXP, SEXP ksSEXP, SEXP delimSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ns(nsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ks(ksSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type delim(delimSEXP);
+    __result = Rcpp::wrap(skipgram_hashed_cppl(texts, types, ns, ks, delim));
+    return __result;
+END_RCPP
+}
+// dfm_skipgram_hashed_cppl
+List dfm_skipgram_hashed_cppl(List texts, const std::vector<std::string>& types, const std::vector<int>& ns, const std::vector<int>& ks, const std::string& delim);
+RcppExport SEXP quanteda_dfm_skipgram_hashed_cppl(SEXP textsSEXP, SEXP typesSEXP, SEXP nsSEXP, SEXP ksSEXP, SEXP delimSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ns(nsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ks(ksSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type delim(delimSEXP);
+    __result = Rcpp::wrap(dfm_skipgram_hashed_cppl(texts, types, ns, ks, delim));
+    return __result;
+END_RCPP
+}
+// profile_enable_cpp
+bool profile_enable_cpp(const bool enable);
+RcppExport SEXP quanteda_profile_enable_cpp(SEXP enableSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const bool >::type enable(enableSEXP);
+    __result = Rcpp::wrap(profile_enable_cpp(enable));
+    return __result;
+END_RCPP
+}
+// profile_compiled_cpp
+bool profile_compiled_cpp();
+RcppExport SEXP quanteda_profile_compiled_cpp() {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    __result = Rcpp::wrap(profile_compiled_cpp());
+    return __result;
+END_RCPP
+}
+// profile_records_cpp
+List profile_records_cpp(const bool clear);
+RcppExport SEXP quanteda_profile_records_cpp(SEXP clearSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const bool >::type clear(clearSEXP);
+    __result = Rcpp::wrap(profile_records_cpp(clear));
+    return __result;
+END_RCPP
+}
 // match_bit
 int match_bit(const std::vector<std::string>& tokens1, const std::vector<std::string>& tokens2);
 RcppExport SEXP quanteda_match_bit(SEXP tokens1SEXP, SEXP tokens2SEXP) {
@@ -32,18 +421,84 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
-// find_sequence_cppl
-Rcpp::List find_sequence_cppl(List texts, const std::vector<std::string>& types, const int& count_min, const double& smooth, const bool& nested);
-RcppExport SEXP quanteda_find_sequence_cppl(SEXP textsSEXP, SEXP typesSEXP, SEXP count_minSEXP, SEXP smoothSEXP, SEXP nestedSEXP) {
+// find_sequence_hashed_cppl
+Rcpp::List find_sequence_hashed_cppl(List texts, const std::vector<int>& types, const int& count_min, const double& smooth, const bool& nested, const int thread);
+RcppExport SEXP quanteda_find_sequence_hashed_cppl(SEXP textsSEXP, SEXP typesSEXP, SEXP count_minSEXP, SEXP smoothSEXP, SEXP nestedSEXP, SEXP threadSEXP) {
 BEGIN_RCPP
     Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
-    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type types(typesSEXP);
     Rcpp::traits::input_parameter< const int& >::type count_min(count_minSEXP);
     Rcpp::traits::input_parameter< const double& >::type smooth(smoothSEXP);
     Rcpp::traits::input_parameter< const bool& >::type nested(nestedSEXP);
-    __result = Rcpp::wrap(find_sequence_cppl(texts, types, count_min, smooth, nested));
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(find_sequence_hashed_cppl(texts, types, count_min, smooth, nested, thread));
+    return __result;
+END_RCPP
+}
+// similarity_cppl
+List similarity_cppl(const IntegerVector& slot_i, const IntegerVector& slot_p, const NumericVector& slot_x, const int n_rows, const int n_cols, const int margin, const IntegerVector& targets, const int n, const std::string& method, const bool sorted, const int thread);
+RcppExport SEXP quanteda_similarity_cppl(SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP n_rowsSEXP, SEXP n_colsSEXP, SEXP marginSEXP, SEXP targetsSEXP, SEXP nSEXP, SEXP methodSEXP, SEXP sortedSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_rows(n_rowsSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_cols(n_colsSEXP);
+    Rcpp::traits::input_parameter< const int >::type margin(marginSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type targets(targetsSEXP);
+    Rcpp::traits::input_parameter< const int >::type n(nSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< const bool >::type sorted(sortedSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(similarity_cppl(slot_i, slot_p, slot_x, n_rows, n_cols, margin, targets, n, method, sorted, thread));
+    return __result;
+END_RCPP
+}
+// tokenize_fast_hashed_cppl
+List tokenize_fast_hashed_cppl(const CharacterVector& texts, const bool split_whitespace, const bool remove_numbers, const bool remove_punct, const bool remove_symbols, const bool remove_twitter, const bool remove_hyphens, const bool remove_url, const int thread);
+RcppExport SEXP quanteda_tokenize_fast_hashed_cppl(SEXP textsSEXP, SEXP split_whitespaceSEXP, SEXP remove_numbersSEXP, SEXP remove_punctSEXP, SEXP remove_symbolsSEXP, SEXP remove_twitterSEXP, SEXP remove_hyphensSEXP, SEXP remove_urlSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const CharacterVector& >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const bool >::type split_whitespace(split_whitespaceSEXP);
+    Rcpp::traits::input_parameter< const bool >::type remove_numbers(remove_numbersSEXP);
+    Rcpp::traits::input_parameter< const bool >::type remove_punct(remove_punctSEXP);
+    Rcpp::traits::input_parameter< const bool >::type remove_symbols(remove_symbolsSEXP);
+    Rcpp::traits::input_parameter< const bool >::type remove_twitter(remove_twitterSEXP);
+    Rcpp::traits::input_parameter< const bool >::type remove_hyphens(remove_hyphensSEXP);
+    Rcpp::traits::input_parameter< const bool >::type remove_url(remove_urlSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(tokenize_fast_hashed_cppl(texts, split_whitespace, remove_numbers, remove_punct, remove_symbols, remove_twitter, remove_hyphens, remove_url, thread));
+    return __result;
+END_RCPP
+}
+// hash_tokens_cppl
+List hash_tokens_cppl(List texts, const CharacterVector& types);
+RcppExport SEXP quanteda_hash_tokens_cppl(SEXP textsSEXP, SEXP typesSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type types(typesSEXP);
+    __result = Rcpp::wrap(hash_tokens_cppl(texts, types));
+    return __result;
+END_RCPP
+}
+// recode_types_hashed_cppl
+List recode_types_hashed_cppl(List texts, const std::vector<int>& ids_new, const int thread);
+RcppExport SEXP quanteda_recode_types_hashed_cppl(SEXP textsSEXP, SEXP ids_newSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ids_new(ids_newSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(recode_types_hashed_cppl(texts, ids_new, thread));
     return __result;
 END_RCPP
 }
@@ -59,31 +514,50 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
-// join_tokens_cppl
-void join_tokens_cppl(List texts, const std::vector<bool>& flags, const CharacterVector& tokens_join, const String& delim);
-RcppExport SEXP quanteda_join_tokens_cppl(SEXP textsSEXP, SEXP flagsSEXP, SEXP tokens_joinSEXP, SEXP delimSEXP) {
+// join_tokens_hashed_cppl
+List join_tokens_hashed_cppl(List texts, const List& seqs, const std::vector<int>& ids_join, const int thread);
+RcppExport SEXP quanteda_join_tokens_hashed_cppl(SEXP textsSEXP, SEXP seqsSEXP, SEXP ids_joinSEXP, SEXP threadSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
     Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
-    Rcpp::traits::input_parameter< const std::vector<bool>& >::type flags(flagsSEXP);
-    Rcpp::traits::input_parameter< const CharacterVector& >::type tokens_join(tokens_joinSEXP);
-    Rcpp::traits::input_parameter< const String& >::type delim(delimSEXP);
-    join_tokens_cppl(texts, flags, tokens_join, delim);
-    return R_NilValue;
+    Rcpp::traits::input_parameter< const List& >::type seqs(seqsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type ids_join(ids_joinSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(join_tokens_hashed_cppl(texts, seqs, ids_join, thread));
+    return __result;
 END_RCPP
 }
 // select_tokens_cppl
-void select_tokens_cppl(Rcpp::List texts, const std::vector<bool>& flags, const std::vector< std::string >& types, const bool& remove, const bool& spacer);
-RcppExport SEXP quanteda_select_tokens_cppl(SEXP textsSEXP, SEXP flagsSEXP, SEXP typesSEXP, SEXP removeSEXP, SEXP spacerSEXP) {
+List select_tokens_cppl(const List& texts, const std::vector<bool>& flags, const CharacterVector& types, const bool& remove, const bool& spacer, const int thread);
+RcppExport SEXP quanteda_select_tokens_cppl(SEXP textsSEXP, SEXP flagsSEXP, SEXP typesSEXP, SEXP removeSEXP, SEXP spacerSEXP, SEXP threadSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< Rcpp::List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const List& >::type texts(textsSEXP);
     Rcpp::traits::input_parameter< const std::vector<bool>& >::type flags(flagsSEXP);
-    Rcpp::traits::input_parameter< const std::vector< std::string >& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const CharacterVector& >::type types(typesSEXP);
     Rcpp::traits::input_parameter< const bool& >::type remove(removeSEXP);
     Rcpp::traits::input_parameter< const bool& >::type spacer(spacerSEXP);
-    select_tokens_cppl(texts, flags, types, remove, spacer);
-    return R_NilValue;
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(select_tokens_cppl(texts, flags, types, remove, spacer, thread));
+    return __result;
+END_RCPP
+}
+// select_tokens_hashed_cppl
+List select_tokens_hashed_cppl(List texts, const std::vector<int>& types, const int n_types, const bool& remove, const bool& spacer, const int thread);
+RcppExport SEXP quanteda_select_tokens_hashed_cppl(SEXP textsSEXP, SEXP typesSEXP, SEXP n_typesSEXP, SEXP removeSEXP, SEXP spacerSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<int>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_types(n_typesSEXP);
+    Rcpp::traits::input_parameter< const bool& >::type remove(removeSEXP);
+    Rcpp::traits::input_parameter< const bool& >::type spacer(spacerSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(select_tokens_hashed_cppl(texts, types, n_types, remove, spacer, thread));
+    return __result;
 END_RCPP
 }
 // split_df_cpp
@@ -97,30 +571,143 @@ BEGIN_RCPP
     return __result;
 END_RCPP
 }
-// deepcopy
-Rcpp::List deepcopy(Rcpp::List x);
-RcppExport SEXP quanteda_deepcopy(SEXP xSEXP) {
+// vocabulary_index_cpp
+SEXP vocabulary_index_cpp(const std::vector<std::string>& types, const std::vector<std::string>& types_folded);
+RcppExport SEXP quanteda_vocabulary_index_cpp(SEXP typesSEXP, SEXP types_foldedSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types(typesSEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type types_folded(types_foldedSEXP);
+    __result = Rcpp::wrap(vocabulary_index_cpp(types, types_folded));
+    return __result;
+END_RCPP
+}
+// vocabulary_find_cpp
+int vocabulary_find_cpp(SEXP objects, SEXP x);
+RcppExport SEXP quanteda_vocabulary_find_cpp(SEXP objectsSEXP, SEXP xSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type objects(objectsSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type x(xSEXP);
+    __result = Rcpp::wrap(vocabulary_find_cpp(objects, x));
+    return __result;
+END_RCPP
+}
+// vocabulary_match_cppl
+List vocabulary_match_cppl(SEXP index_, const std::vector<std::string>& patterns, const bool glob, const bool case_insensitive, const int thread);
+RcppExport SEXP quanteda_vocabulary_match_cppl(SEXP index_SEXP, SEXP patternsSEXP, SEXP globSEXP, SEXP case_insensitiveSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< SEXP >::type index_(index_SEXP);
+    Rcpp::traits::input_parameter< const std::vector<std::string>& >::type patterns(patternsSEXP);
+    Rcpp::traits::input_parameter< const bool >::type glob(globSEXP);
+    Rcpp::traits::input_parameter< const bool >::type case_insensitive(case_insensitiveSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(vocabulary_match_cppl(index_, patterns, glob, case_insensitive, thread));
+    return __result;
+END_RCPP
+}
+// vocabulary_postings_cppl
+List vocabulary_postings_cppl(List texts, const int n_types, const int thread);
+RcppExport SEXP quanteda_vocabulary_postings_cppl(SEXP textsSEXP, SEXP n_typesSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< List >::type texts(textsSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_types(n_typesSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(vocabulary_postings_cppl(texts, n_types, thread));
+    return __result;
+END_RCPP
+}
+// dfm_weight_cppl
+NumericVector dfm_weight_cppl(NumericVector slot_x, const IntegerVector& slot_i, const IntegerVector& slot_p, const int transform, const double base, const std::vector<double>& row_div, const std::vector<double>& col_mul, const double factor, const double shift, const bool inplace, const int thread);
+RcppExport SEXP quanteda_dfm_weight_cppl(SEXP slot_xSEXP, SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP transformSEXP, SEXP baseSEXP, SEXP row_divSEXP, SEXP col_mulSEXP, SEXP factorSEXP, SEXP shiftSEXP, SEXP inplaceSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< NumericVector >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const int >::type transform(transformSEXP);
+    Rcpp::traits::input_parameter< const double >::type base(baseSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type row_div(row_divSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type col_mul(col_mulSEXP);
+    Rcpp::traits::input_parameter< const double >::type factor(factorSEXP);
+    Rcpp::traits::input_parameter< const double >::type shift(shiftSEXP);
+    Rcpp::traits::input_parameter< const bool >::type inplace(inplaceSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(dfm_weight_cppl(slot_x, slot_i, slot_p, transform, base, row_div, col_mul, factor, shift, inplace, thread));
+    return __result;
+END_RCPP
+}
+// dfm_row_max_cppl
+NumericVector dfm_row_max_cppl(const NumericVector& slot_x, const IntegerVector& slot_i, const IntegerVector& slot_p, const int n_rows, const int thread);
+RcppExport SEXP quanteda_dfm_row_max_cppl(SEXP slot_xSEXP, SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP n_rowsSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_rows(n_rowsSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(dfm_row_max_cppl(slot_x, slot_i, slot_p, n_rows, thread));
+    return __result;
+END_RCPP
+}
+// dfm_docfreq_cppl
+IntegerVector dfm_docfreq_cppl(const NumericVector& slot_x, const IntegerVector& slot_p, const double threshold, const int thread);
+RcppExport SEXP quanteda_dfm_docfreq_cppl(SEXP slot_xSEXP, SEXP slot_pSEXP, SEXP thresholdSEXP, SEXP threadSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject __result;
+    Rcpp::RNGScope __rngScope;
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const double >::type threshold(thresholdSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(dfm_docfreq_cppl(slot_x, slot_p, threshold, thread));
+    return __result;
+END_RCPP
+}
+// leading_left_singular_cppl
+Rcpp::List leading_left_singular_cppl(const IntegerVector& slot_i, const IntegerVector& slot_p, const NumericVector& slot_x, const int N, const int K, const double tol, const int max_iter);
+RcppExport SEXP quanteda_leading_left_singular_cppl(SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP NSEXP, SEXP KSEXP, SEXP tolSEXP, SEXP max_iterSEXP) {
 BEGIN_RCPP
     Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< Rcpp::List >::type x(xSEXP);
-    __result = Rcpp::wrap(deepcopy(x));
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const int >::type N(NSEXP);
+    Rcpp::traits::input_parameter< const int >::type K(KSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< const int >::type max_iter(max_iterSEXP);
+    __result = Rcpp::wrap(leading_left_singular_cppl(slot_i, slot_p, slot_x, N, K, tol, max_iter));
     return __result;
 END_RCPP
 }
 // wordfishcpp
-Rcpp::List wordfishcpp(SEXP wfm, SEXP dir, SEXP priors, SEXP tol, SEXP disp, SEXP dispfloor);
-RcppExport SEXP quanteda_wordfishcpp(SEXP wfmSEXP, SEXP dirSEXP, SEXP priorsSEXP, SEXP tolSEXP, SEXP dispSEXP, SEXP dispfloorSEXP) {
+Rcpp::List wordfishcpp(const IntegerVector& slot_i, const IntegerVector& slot_p, const NumericVector& slot_x, const int N, const int K, const IntegerVector& dir, const std::vector<double>& priors, const std::vector<double>& tol, const int disp, const double dispfloor, const int thread);
+RcppExport SEXP quanteda_wordfishcpp(SEXP slot_iSEXP, SEXP slot_pSEXP, SEXP slot_xSEXP, SEXP NSEXP, SEXP KSEXP, SEXP dirSEXP, SEXP priorsSEXP, SEXP tolSEXP, SEXP dispSEXP, SEXP dispfloorSEXP, SEXP threadSEXP) {
 BEGIN_RCPP
     Rcpp::RObject __result;
     Rcpp::RNGScope __rngScope;
-    Rcpp::traits::input_parameter< SEXP >::type wfm(wfmSEXP);
-    Rcpp::traits::input_parameter< SEXP >::type dir(dirSEXP);
-    Rcpp::traits::input_parameter< SEXP >::type priors(priorsSEXP);
-    Rcpp::traits::input_parameter< SEXP >::type tol(tolSEXP);
-    Rcpp::traits::input_parameter< SEXP >::type disp(dispSEXP);
-    Rcpp::traits::input_parameter< SEXP >::type dispfloor(dispfloorSEXP);
-    __result = Rcpp::wrap(wordfishcpp(wfm, dir, priors, tol, disp, dispfloor));
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_i(slot_iSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type slot_p(slot_pSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type slot_x(slot_xSEXP);
+    Rcpp::traits::input_parameter< const int >::type N(NSEXP);
+    Rcpp::traits::input_parameter< const int >::type K(KSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type dir(dirSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type priors(priorsSEXP);
+    Rcpp::traits::input_parameter< const std::vector<double>& >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< const int >::type disp(dispSEXP);
+    Rcpp::traits::input_parameter< const double >::type dispfloor(dispfloorSEXP);
+    Rcpp::traits::input_parameter< const int >::type thread(threadSEXP);
+    __result = Rcpp::wrap(wordfishcpp(slot_i, slot_p, slot_x, N, K, dir, priors, tol, disp, dispfloor, thread));
     return __result;
 END_RCPP
 }
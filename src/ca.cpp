@@ -0,0 +1,110 @@
+// includes from the plugin
+#include <RcppArmadillo.h>
+#include <random>
+#include <algorithm>
+#include "residuals.h"
+#include "profile.h"
+
+using namespace Rcpp;
+
+// [[Rcpp::depends(RcppArmadillo)]]
+
+// Leading nd singular triplets of the residual matrix by randomized subspace
+// iteration on a block of nd + 10 vectors, iterated until the leading nd
+// singular values converge. Only products with the sparse counts are taken.
+// The random start is drawn from a fixed seed, not from R's generator.
+// Returns the number of iterations.
+int truncated_svd(const ResidualMatrix &C, const int N, const int K, const int nd,
+                  const double tol, const int max_iter,
+                  arma::mat &U, arma::vec &s, arma::mat &V){
+
+    int l = std::min(std::min(N, K), nd + 10);
+    std::mt19937 gen(5489u);
+    arma::mat Omega(K, l);
+    for (int k = 0; k < K; k++) {
+        for (int j = 0; j < l; j++) Omega(k, j) = 2.0 * gen() / gen.max() - 1.0;
+    }
+
+    arma::mat Q, R, Z, Ub, Vb;
+    arma::vec s_last;
+    arma::qr_econ(Q, R, C.times(Omega));
+    int iter = 0;
+    while (iter++ < max_iter) {
+        Z = C.trans_times(Q); // B = Q' C = Z'
+        arma::svd_econ(Ub, s, Vb, arma::mat(arma::trans(Z)));
+        // the subspace is exact once it spans all the rows or columns
+        if (l == std::min(N, K)) break;
+        if (iter > 1 && arma::max(arma::abs(s.head(nd) - s_last.head(nd))) <= tol * s(0)) break;
+        s_last = s;
+        arma::qr_econ(Q, R, Z);
+        arma::qr_econ(Q, R, C.times(Q));
+    }
+    U = Q * Ub.cols(0, nd - 1);
+    V = Vb.cols(0, nd - 1);
+    s = arma::vec(s.head(nd));
+    return iter;
+}
+
+// Correspondence analysis of the slots of a dgCMatrix of N documents and K
+// features, with smooth added to every count, computing nd dimensions.
+// Returns the singular values of the standardized residuals, the standard
+// coordinates, masses, chi-squared distances and inertias of rows and columns.
+// [[Rcpp::export]]
+List ca_sparse_cppl(const IntegerVector &slot_i, const IntegerVector &slot_p,
+                    const NumericVector &slot_x, const int N, const int K,
+                    const int nd, const double smooth, const double tol,
+                    const int max_iter, const int thread){
+
+    PROFILE_CALL("ca_sparse_cppl");
+    PROFILE_STAGE("initialize");
+    if (nd < 1 || nd >= std::min(N, K)) stop("Invalid number of dimensions");
+    SparseCounts Y = sparse_counts(slot_i, slot_p, slot_x, N, K);
+    ResidualMatrix C(Y, thread, smooth);
+    for (int i = 0; i < N; i++) {
+        if (C.rsum[i] <= 0) stop("Documents must have positive counts");
+    }
+    for (int k = 0; k < K; k++) {
+        if (C.csum[k] <= 0) stop("Features must have positive counts");
+    }
+    PROFILE_COUNT("documents", N);
+    PROFILE_COUNT("features", K);
+    PROFILE_COUNT("nonzero", slot_x.size());
+
+    PROFILE_STAGE("decompose");
+    arma::mat U, V;
+    arma::vec s;
+    int iterations = truncated_svd(C, N, K, nd, tol, max_iter, U, s, V);
+    PROFILE_COUNT("iterations", iterations);
+
+    PROFILE_STAGE("coordinates");
+    // The standardized residuals are C / sqrt(asum)
+    std::vector<double> row_sq, col_sq;
+    C.squares(row_sq, col_sq);
+    NumericVector sv(nd), rowmass(N), rowdist(N), rowinertia(N),
+                  colmass(K), coldist(K), colinertia(K);
+    NumericMatrix rowcoord(N, nd), colcoord(K, nd);
+    for (int d = 0; d < nd; d++) sv[d] = s(d) / std::sqrt(C.asum);
+    for (int i = 0; i < N; i++) {
+        rowmass[i] = C.rsum[i] / C.asum;
+        rowinertia[i] = std::max(row_sq[i], 0.0) / C.asum;
+        rowdist[i] = std::sqrt(rowinertia[i] / rowmass[i]);
+        for (int d = 0; d < nd; d++) rowcoord(i, d) = U(i, d) / std::sqrt(rowmass[i]);
+    }
+    for (int k = 0; k < K; k++) {
+        colmass[k] = C.csum[k] / C.asum;
+        colinertia[k] = std::max(col_sq[k], 0.0) / C.asum;
+        coldist[k] = std::sqrt(colinertia[k] / colmass[k]);
+        for (int d = 0; d < nd; d++) colcoord(k, d) = V(k, d) / std::sqrt(colmass[k]);
+    }
+
+    return List::create(_["sv"] = sv,
+                        _["rowmass"] = rowmass,
+                        _["rowdist"] = rowdist,
+                        _["rowinertia"] = rowinertia,
+                        _["rowcoord"] = rowcoord,
+                        _["colmass"] = colmass,
+                        _["coldist"] = coldist,
+                        _["colinertia"] = colinertia,
+                        _["colcoord"] = colcoord,
+                        _["iterations"] = iterations);
+}
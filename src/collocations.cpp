@@ -0,0 +1,229 @@
+#include "quanteda.h"
+#include "profile.h"
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Sequences of two or three type IDs packed into a key; the third ID is 0 in
+// bigrams
+struct Trigram {
+    uint64_t first; // first and second IDs
+    unsigned int third;
+    bool operator==(const Trigram &other) const {
+        return first == other.first && third == other.third;
+    }
+};
+
+struct hash_trigram {
+    std::size_t operator()(const Trigram &key) const {
+        std::size_t seed = std::hash<uint64_t>()(key.first);
+        seed ^= key.third + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+typedef std::unordered_map<Trigram, int, hash_trigram> MapTrigrams;
+typedef std::unordered_map<uint64_t, int> MapBigrams;
+
+inline uint64_t pack(const unsigned int id1, const unsigned int id2){
+    return ((uint64_t)id1 << 32) | id2;
+}
+
+// Count the adjacent sequences of a document, skipping those that include
+// padding or, unless spanning punctuation, a punctuation mark. The count of
+// each type in each position of the sequences is also added.
+void count_sequences(const int *text, const std::size_t len_text, const std::size_t size,
+                     const std::vector<int> &puncts, const bool span_punct,
+                     MapTrigrams &counts_seqs, std::vector< std::vector<int> > &counts_positions){
+    if (len_text < size) return;
+    for (std::size_t i = 0; i <= len_text - size; i++) {
+        bool valid = true;
+        for (std::size_t j = 0; j < size && valid; j++) {
+            int id = text[i + j];
+            if (id == 0 || (!span_punct && puncts[id - 1])) valid = false;
+        }
+        if (!valid) continue;
+        Trigram key = {pack(text[i], text[i + 1]), size == 3 ? (unsigned int)text[i + 2] : 0};
+        counts_seqs[key]++;
+        for (std::size_t j = 0; j < size; j++) counts_positions[j][text[i + j]]++;
+    }
+}
+
+// Score a bigram by its 2x2 table of counts
+void score_bigram(const double n11, const double c1, const double c2, const double N,
+                  double &lr, double &chi2, double &pmi, double &dice){
+    const double epsilon = 0.000000001; // to offset zero cell counts
+    double n12 = c1 - n11;
+    double n21 = c2 - n11;
+    double n22 = N - (n11 + n12 + n21);
+    double m11 = std::exp(std::log(c1) + std::log(c2) - std::log(N));
+    double m12 = std::exp(std::log(c1) + std::log(N - c2) - std::log(N));
+    double m21 = std::exp(std::log(c2) + std::log(N - c1) - std::log(N));
+    double m22 = std::exp(std::log(N - c2) + std::log(N - c1) - std::log(N));
+    lr = 2 * (n11 * std::log(n11 / (m11 + epsilon) + epsilon) +
+              n12 * std::log(n12 / (m12 + epsilon) + epsilon) +
+              n21 * std::log(n21 / (m21 + epsilon) + epsilon) +
+              n22 * std::log(n22 / (m22 + epsilon) + epsilon));
+    chi2 = (n11 - m11) * (n11 - m11) / m11 + (n12 - m12) * (n12 - m12) / m12 +
+           (n21 - m21) * (n21 - m21) / m21 + (n22 - m22) * (n22 - m22) / m22;
+    pmi = std::log(n11 / m11);
+    dice = 2 * n11 / (2 * n11 + n12 + n21);
+}
+
+// Score a trigram by its 2x2x2 table of counts against the model of
+// independence of the three words, P(w1, w2, w3) = P(w1)P(w2)P(w3)
+void score_trigram(const double n111, const double c1, const double c2, const double c3,
+                   const double c12, const double c13, const double c23, const double N,
+                   double &lr, double &chi2, double &pmi, double &dice){
+    const double epsilon = 0.000000001;
+    double n[8];
+    n[0] = n111;                          // 111
+    n[1] = c12 - n111;                    // 112
+    n[2] = c13 - n111;                    // 121
+    n[3] = c1 - c12 - n[2];               // 122
+    n[4] = c23 - n111;                    // 211
+    n[5] = c2 - c12 - n[4];               // 212
+    n[6] = c3 - c13 - n[4];               // 221
+    n[7] = N - c1 - n[4] - n[5] - n[6];   // 222
+    // marginals of the first, second and third words being present (0) or not (1)
+    double r1[2] = {n[0] + n[2] + n[1] + n[3], n[4] + n[6] + n[5] + n[7]};
+    double r2[2] = {n[0] + n[4] + n[1] + n[5], n[2] + n[6] + n[3] + n[7]};
+    double r3[2] = {n[0] + n[4] + n[2] + n[6], n[1] + n[5] + n[3] + n[7]};
+    lr = 0;
+    chi2 = 0;
+    double m111 = 0;
+    for (int k = 0; k < 8; k++) {
+        int a = (k >> 2) & 1, b = (k >> 1) & 1, c = k & 1;
+        double m = std::exp(std::log(r1[a]) + std::log(r2[b]) + std::log(r3[c]) - 2 * std::log(N));
+        if (k == 0) m111 = m;
+        lr += n[k] * std::log(n[k] / m + epsilon);
+        chi2 += (n[k] - m) * (n[k] - m) / m;
+    }
+    lr *= 2;
+    pmi = std::log(n111 / m111);
+    dice = 2 * n111 / (r1[0] + r2[0] + r3[0]);
+}
+
+// Count the bigrams or trigrams of hashed tokens and score their association.
+// Documents are counted in parallel into hash tables of each thread, which
+// are then merged. All sequences count towards the marginal totals, but only
+// those occurring at least min_count times are scored and returned.
+// [[Rcpp::export]]
+List collocations_hashed_cppl(List texts,
+                              const std::vector<int> &puncts,
+                              const int size,
+                              const bool span_punct,
+                              const int min_count,
+                              const int thread){
+
+    if (size != 2 && size != 3) stop("Only bigram and trigram collocations are implemented");
+    PROFILE_CALL("collocations_hashed_cppl");
+    PROFILE_STAGE("count");
+    int n_types = puncts.size();
+    int n_docs = texts.size();
+    std::vector<const int*> ptrs(n_docs);
+    std::vector<std::size_t> lens(n_docs);
+    for (int h = 0; h < n_docs; h++) {
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (std::size_t i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    MapTrigrams counts_seqs;
+    std::vector< std::vector<int> > counts_positions(size, std::vector<int>(n_types + 1, 0));
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        MapTrigrams counts_local;
+        std::vector< std::vector<int> > positions_local(size, std::vector<int>(n_types + 1, 0));
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            count_sequences(ptrs[h], lens[h], size, puncts, span_punct, counts_local, positions_local);
+        }
+        #ifdef _OPENMP
+        #pragma omp critical
+        #endif
+        {
+            for (auto it = counts_local.begin(); it != counts_local.end(); ++it) {
+                counts_seqs[it->first] += it->second;
+            }
+            for (int j = 0; j < size; j++) {
+                for (int g = 0; g <= n_types; g++) counts_positions[j][g] += positions_local[j][g];
+            }
+        }
+    }
+
+    PROFILE_COUNT("documents", n_docs);
+    PROFILE_COUNT("sequences_counted", counts_seqs.size());
+    PROFILE_COUNT("sequences_load_factor", counts_seqs.load_factor());
+
+    // Counts of the pairs of words in trigrams
+    PROFILE_STAGE("margins");
+    MapBigrams counts_12, counts_13, counts_23;
+    double N = 0;
+    for (auto it = counts_seqs.begin(); it != counts_seqs.end(); ++it) {
+        N += it->second;
+        if (size == 3) {
+            unsigned int id1 = it->first.first >> 32, id2 = it->first.first & 0xFFFFFFFF, id3 = it->first.third;
+            counts_12[pack(id1, id2)] += it->second;
+            counts_13[pack(id1, id3)] += it->second;
+            counts_23[pack(id2, id3)] += it->second;
+        }
+    }
+
+    // Sequences are pruned before scoring
+    std::vector<Trigram> seqs;
+    std::vector<int> counts;
+    for (auto it = counts_seqs.begin(); it != counts_seqs.end(); ++it) {
+        if (it->second < min_count) continue;
+        seqs.push_back(it->first);
+        counts.push_back(it->second);
+    }
+    MapTrigrams().swap(counts_seqs);
+
+    std::size_t n_seqs = seqs.size();
+    PROFILE_COUNT("sequences_kept", n_seqs);
+    PROFILE_STAGE("score");
+    IntegerVector ids1(n_seqs), ids2(n_seqs), ids3(n_seqs), counts_all(n_seqs);
+    std::vector<double> lr(n_seqs), chi2(n_seqs), pmi(n_seqs), dice(n_seqs);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread)
+    #endif
+    for (std::size_t k = 0; k < n_seqs; k++) {
+        unsigned int id1 = seqs[k].first >> 32, id2 = seqs[k].first & 0xFFFFFFFF, id3 = seqs[k].third;
+        if (size == 2) {
+            score_bigram(counts[k], counts_positions[0][id1], counts_positions[1][id2], N,
+                         lr[k], chi2[k], pmi[k], dice[k]);
+        } else {
+            score_trigram(counts[k], counts_positions[0][id1], counts_positions[1][id2], counts_positions[2][id3],
+                          counts_12.find(pack(id1, id2))->second,
+                          counts_13.find(pack(id1, id3))->second,
+                          counts_23.find(pack(id2, id3))->second, N,
+                          lr[k], chi2[k], pmi[k], dice[k]);
+        }
+    }
+
+    PROFILE_STAGE("write");
+    for (std::size_t k = 0; k < n_seqs; k++) {
+        ids1[k] = seqs[k].first >> 32;
+        ids2[k] = seqs[k].first & 0xFFFFFFFF;
+        ids3[k] = seqs[k].third;
+        counts_all[k] = counts[k];
+    }
+    return List::create(_["word1"] = ids1,
+                        _["word2"] = ids2,
+                        _["word3"] = ids3,
+                        _["count"] = counts_all,
+                        _["G2"] = NumericVector(lr.begin(), lr.end()),
+                        _["X2"] = NumericVector(chi2.begin(), chi2.end()),
+                        _["pmi"] = NumericVector(pmi.begin(), pmi.end()),
+                        _["dice"] = NumericVector(dice.begin(), dice.end()));
+}
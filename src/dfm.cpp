@@ -0,0 +1,119 @@
+#include "quanteda.h"
+#include "profile.h"
+#include <numeric>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Count the features of one document using a counter array owned by the
+// thread, so that nothing is allocated per document except the result
+void count_features(const int *text, const int len_text,
+                    std::vector<int> &counter, std::vector<unsigned int> &touched,
+                    Counts &counts){
+    touched.clear();
+    for (int i = 0; i < len_text; i++) {
+        unsigned int id = text[i];
+        if (id == 0) continue; // padding
+        if (counter[id]++ == 0) touched.push_back(id);
+    }
+    counts.reserve(touched.size());
+    for (std::size_t j = 0; j < touched.size(); j++) {
+        counts.push_back(std::make_pair(touched[j], counter[touched[j]]));
+        counter[touched[j]] = 0;
+    }
+}
+
+// Make the slots of a dgCMatrix from counts of features in documents. Types
+// that do not occur are dropped unless drop is false, and the IDs of the
+// remaining types are returned in "types". Counts are released as they are
+// copied.
+List dfm_slots(std::vector<Counts> &counts_docs, const int n_types, const bool drop){
+
+    int n_docs = counts_docs.size();
+
+    // Number of documents in which each type occurs
+    std::vector<int> nnz_types(n_types + 1, 0);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < counts_docs[h].size(); j++) {
+            nnz_types[counts_docs[h][j].first]++;
+        }
+    }
+
+    // Columns of the types that occur, and pointers to their start
+    std::vector<int> cols(n_types + 1, -1);
+    std::vector<int> types_used;
+    std::vector<int> p(1, 0);
+    for (int g = 1; g <= n_types; g++) {
+        if (drop && nnz_types[g] == 0) continue;
+        cols[g] = types_used.size();
+        types_used.push_back(g);
+        p.push_back(p.back() + nnz_types[g]);
+    }
+
+    // Documents are visited in order, so row indexes are sorted within columns
+    int nnz = p.back();
+    IntegerVector slot_i(nnz);
+    NumericVector slot_x(nnz);
+    std::vector<int> pos(p.begin(), p.end() - 1);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < counts_docs[h].size(); j++) {
+            int k = pos[cols[counts_docs[h][j].first]]++;
+            slot_i[k] = h;
+            slot_x[k] = counts_docs[h][j].second;
+        }
+        Counts().swap(counts_docs[h]); // release memory as we go
+    }
+
+    return List::create(_["i"] = slot_i,
+                        _["p"] = IntegerVector(p.begin(), p.end()),
+                        _["x"] = slot_x,
+                        _["types"] = IntegerVector(types_used.begin(), types_used.end()));
+}
+
+// Build the slots of a dgCMatrix from hashed tokens
+// [[Rcpp::export]]
+List dfm_hashed_cppl(List texts, const int n_types, const int thread){
+
+    PROFILE_CALL("dfm_hashed_cppl");
+    int n_docs = texts.size();
+    std::vector<const int*> ptrs(n_docs);
+    std::vector<int> lens(n_docs);
+    for (int h = 0; h < n_docs; h++) {
+        if (TYPEOF(texts[h]) != INTSXP) {
+            stop("Each element of the list must be an integer vector");
+        }
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (int i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    // Documents are counted in parallel; R's memory is only read here
+    PROFILE_STAGE("count");
+    std::vector<Counts> counts_docs(n_docs);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<int> counter(n_types + 1, 0);
+        std::vector<unsigned int> touched;
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            count_features(ptrs[h], lens[h], counter, touched, counts_docs[h]);
+        }
+    }
+    PROFILE_COUNT("documents", n_docs);
+    PROFILE_COUNT("tokens", std::accumulate(lens.begin(), lens.end(), 0.0));
+    PROFILE_COUNT("types", n_types);
+
+    PROFILE_STAGE("slots");
+    List slots = dfm_slots(counts_docs, n_types);
+    PROFILE_COUNT("nonzero", Rf_length(slots["x"]));
+    return slots;
+}
@@ -0,0 +1,205 @@
+#include "quanteda.h"
+#include <climits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Count the features of one document (defined in dfm.cpp)
+void count_features(const int *text, const int len_text,
+                    std::vector<int> &counter, std::vector<unsigned int> &touched,
+                    Counts &counts);
+
+// A dfm to which documents are added a batch at a time. Documents are kept as
+// rows of feature indexes and counts, and features are indexed in a hash table
+// that lives as long as the builder, so that adding documents takes time in
+// proportion to their counts however many documents have been added before.
+class DfmBuilder {
+public:
+    std::vector<std::string> features;
+    std::vector<std::string> docnames;
+    std::unordered_map<std::string, int> map_features;
+    std::vector<std::size_t> rows; // start of each document in cols and vals
+    std::vector<int> cols;
+    std::vector<double> vals;
+    std::vector<std::size_t> last; // position of each feature in cols, if in the current document
+
+    DfmBuilder() : rows(1, 0) {}
+
+    // Column of a feature, which is added if unseen
+    int feature(const std::string &feature) {
+        auto it = map_features.emplace(feature, features.size());
+        if (it.second) {
+            features.push_back(feature);
+            last.push_back(0);
+        }
+        return it.first->second;
+    }
+
+    // Add a count to the current document, merging counts of the same feature
+    void add(const int col, const double x) {
+        std::size_t pos = last[col];
+        if (pos >= rows.back() && pos < cols.size() && cols[pos] == col) {
+            vals[pos] += x;
+            return;
+        }
+        last[col] = cols.size();
+        cols.push_back(col);
+        vals.push_back(x);
+    }
+
+    void end_document(const std::string &docname) {
+        if (cols.size() > INT_MAX) stop("Too many counts for a dfm");
+        rows.push_back(cols.size());
+        docnames.push_back(docname);
+    }
+};
+
+DfmBuilder* get_builder(SEXP builder_){
+    XPtr<DfmBuilder> builder(builder_);
+    if (builder.get() == NULL) stop("The dfm builder is no longer valid, e.g. after it was saved and loaded");
+    return builder.get();
+}
+
+// [[Rcpp::export]]
+SEXP dfm_builder_new_cpp(){
+    XPtr<DfmBuilder> builder(new DfmBuilder, true);
+    return builder;
+}
+
+// Add documents of hashed tokens to a builder. Documents are counted in
+// parallel by the IDs of their types, which are then mapped to columns of the
+// builder in order of first appearance, adding the types not seen before.
+// [[Rcpp::export]]
+void dfm_builder_add_tokens_cppl(SEXP builder_,
+                                 List texts,
+                                 const std::vector<std::string> &types,
+                                 const std::vector<std::string> &docnames,
+                                 const int thread){
+
+    DfmBuilder *builder = get_builder(builder_);
+    int n_types = types.size();
+    int n_docs = texts.size();
+    if ((int)docnames.size() != n_docs) stop("Invalid number of document names");
+    std::vector<const int*> ptrs(n_docs);
+    std::vector<int> lens(n_docs);
+    for (int h = 0; h < n_docs; h++) {
+        if (TYPEOF(texts[h]) != INTSXP) {
+            stop("Each element of the list must be an integer vector");
+        }
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (int i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    std::vector<Counts> counts_docs(n_docs);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<int> counter(n_types + 1, 0);
+        std::vector<unsigned int> touched;
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            count_features(ptrs[h], lens[h], counter, touched, counts_docs[h]);
+        }
+    }
+
+    // Only types that occur are given columns
+    std::vector<int> cols_types(n_types + 1, -1);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < counts_docs[h].size(); j++) {
+            unsigned int id = counts_docs[h][j].first;
+            if (cols_types[id] < 0) cols_types[id] = builder->feature(types[id - 1]);
+            builder->add(cols_types[id], counts_docs[h][j].second);
+        }
+        builder->end_document(docnames[h]);
+        Counts().swap(counts_docs[h]);
+    }
+}
+
+// Add the documents of a dfm, given as the slots of a dgCMatrix, to a builder.
+// All the features of the dfm are added, including those that do not occur.
+// [[Rcpp::export]]
+void dfm_builder_add_dfm_cpp(SEXP builder_,
+                             const std::vector<int> &slot_i,
+                             const std::vector<int> &slot_p,
+                             const std::vector<double> &slot_x,
+                             const std::vector<std::string> &features,
+                             const std::vector<std::string> &docnames){
+
+    DfmBuilder *builder = get_builder(builder_);
+    int n_docs = docnames.size();
+    int n_features = features.size();
+    if ((int)slot_p.size() != n_features + 1 || slot_p[0] != 0 ||
+        (std::size_t)slot_p[n_features] != slot_i.size() || slot_i.size() != slot_x.size())
+        stop("Invalid slots of a dfm");
+
+    // Counts are turned from columns into rows
+    std::vector<int> cols_features(n_features);
+    for (int j = 0; j < n_features; j++) cols_features[j] = builder->feature(features[j]);
+    std::vector< std::vector< std::pair<int, double> > > rows_docs(n_docs);
+    for (int j = 0; j < n_features; j++) {
+        for (int k = slot_p[j]; k < slot_p[j + 1]; k++) {
+            if (slot_i[k] < 0 || slot_i[k] >= n_docs) stop("Invalid row index of a dfm");
+            if (slot_x[k] == 0) continue;
+            rows_docs[slot_i[k]].push_back(std::make_pair(cols_features[j], slot_x[k]));
+        }
+    }
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < rows_docs[h].size(); j++) {
+            builder->add(rows_docs[h][j].first, rows_docs[h][j].second);
+        }
+        builder->end_document(docnames[h]);
+    }
+}
+
+// Number of documents, features and counts in a builder
+// [[Rcpp::export]]
+List dfm_builder_info_cpp(SEXP builder_){
+    DfmBuilder *builder = get_builder(builder_);
+    return List::create(_["ndoc"] = (int)builder->docnames.size(),
+                        _["nfeature"] = (int)builder->features.size(),
+                        _["nnz"] = (double)builder->cols.size());
+}
+
+// Make the slots of a dgCMatrix from the documents added to a builder, which
+// is left as it is so that more documents can be added
+// [[Rcpp::export]]
+List dfm_builder_slots_cpp(SEXP builder_){
+
+    DfmBuilder *builder = get_builder(builder_);
+    int n_docs = builder->docnames.size();
+    int n_features = builder->features.size();
+    const std::vector<std::size_t> &rows = builder->rows;
+    const std::vector<int> &cols = builder->cols;
+    const std::vector<double> &vals = builder->vals;
+
+    std::vector<int> p(n_features + 1, 0);
+    for (std::size_t k = 0; k < cols.size(); k++) p[cols[k] + 1]++;
+    for (int j = 0; j < n_features; j++) p[j + 1] += p[j];
+
+    // Documents are visited in order, so row indexes are sorted within columns
+    IntegerVector slot_i(cols.size());
+    NumericVector slot_x(cols.size());
+    std::vector<int> pos(p.begin(), p.end() - 1);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t k = rows[h]; k < rows[h + 1]; k++) {
+            int m = pos[cols[k]]++;
+            slot_i[m] = h;
+            slot_x[m] = vals[k];
+        }
+    }
+
+    return List::create(_["i"] = slot_i,
+                        _["p"] = IntegerVector(p.begin(), p.end()),
+                        _["x"] = slot_x,
+                        _["docnames"] = as_utf8(builder->docnames),
+                        _["features"] = as_utf8(builder->features));
+}
@@ -0,0 +1,158 @@
+#include "quanteda.h"
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Length of the UTF-8 character starting with byte b
+inline std::size_t utf8_length(const unsigned char b){
+    if (b >= 0xF0) return 4;
+    if (b >= 0xE0) return 3;
+    if (b >= 0xC0) return 2;
+    return 1;
+}
+
+// Whether a string matches a glob pattern, in which "*" matches any number of
+// characters and "?" a single character. On a mismatch, only the last "*" is
+// backtracked, so that matching is linear in most cases.
+bool match_glob(const std::string &pattern, const std::string &str){
+    std::size_t p = 0, s = 0;
+    std::size_t p_star = std::string::npos, s_star = 0;
+    while (s < str.size()) {
+        if (p < pattern.size() && pattern[p] == '*') {
+            p_star = p++;
+            s_star = s;
+        } else if (p < pattern.size() && pattern[p] == '?') {
+            p++;
+            s = std::min(s + utf8_length(str[s]), str.size());
+        } else if (p < pattern.size() && pattern[p] == str[s]) {
+            p++;
+            s++;
+        } else if (p_star != std::string::npos) {
+            p = p_star + 1;
+            s_star = std::min(s_star + utf8_length(str[s_star]), str.size());
+            s = s_star;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') p++;
+    return p == pattern.size();
+}
+
+// Add all the sequences of type IDs that a value of several words matches,
+// one type for each word, to the sequences of the dictionary
+void expand_value(const List &ids_words, const std::size_t i, Text &seq,
+                  const int key, MapNgrams &map_seqs,
+                  std::vector< std::vector<int> > &keys_seqs){
+    if (i == (std::size_t)ids_words.size()) {
+        auto it = map_seqs.emplace(seq, keys_seqs.size());
+        if (it.second) keys_seqs.push_back(std::vector<int>());
+        std::vector<int> &keys = keys_seqs[it.first->second];
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) keys.push_back(key);
+        return;
+    }
+    IntegerVector ids = ids_words[i];
+    for (int g = 0; g < ids.size(); g++) {
+        seq.push_back(ids[g]);
+        expand_value(ids_words, i + 1, seq, key, map_seqs, keys_seqs);
+        seq.pop_back();
+    }
+}
+
+// Count the keys matched in a document, taking the longest sequence matched
+// at each position, and also the tokens not matched unless exclusive. Keys
+// are counted as the types after the last type of the tokens.
+void count_keys(const int *text, const std::size_t len_text,
+                const TrieSequences &trie, const std::vector< std::vector<int> > &keys_seqs,
+                const unsigned int n_types, const bool exclusive,
+                std::vector<int> &counter, std::vector<unsigned int> &touched,
+                Counts &counts){
+    touched.clear();
+    std::size_t i = 0;
+    while (i < len_text) {
+        int value = 0;
+        std::size_t len_match = trie.match_longest(text, i, len_text, value);
+        if (len_match > 0) {
+            const std::vector<int> &keys = keys_seqs[value - 1];
+            for (std::size_t k = 0; k < keys.size(); k++) {
+                unsigned int id = n_types + keys[k];
+                if (counter[id]++ == 0) touched.push_back(id);
+            }
+            i += len_match;
+        } else {
+            unsigned int id = text[i];
+            if (!exclusive && id != 0) {
+                if (counter[id]++ == 0) touched.push_back(id);
+            }
+            i++;
+        }
+    }
+    counts.reserve(touched.size());
+    for (std::size_t j = 0; j < touched.size(); j++) {
+        counts.push_back(std::make_pair(touched[j], counter[touched[j]]));
+        counter[touched[j]] = 0;
+    }
+}
+
+// Count the keys of a dictionary in hashed tokens, returning the slots of a
+// dgCMatrix as dfm_hashed_cppl() does. Each value is given as the IDs of the
+// types matched by each of its words, and all the sequences of types that a
+// value matches are compiled into a single trie, so that values of many words
+// are matched in one pass over each document. Key k is the column of type
+// n_types + k.
+// [[Rcpp::export]]
+List dfm_dictionary_hashed_cppl(List texts,
+                                const int n_types,
+                                const List &values,
+                                const std::vector<int> &keys,
+                                const int n_keys,
+                                const bool exclusive,
+                                const int thread){
+
+    MapNgrams map_seqs;
+    std::vector< std::vector<int> > keys_seqs;
+    Text seq;
+    for (int v = 0; v < values.size(); v++) {
+        if (keys[v] < 1 || keys[v] > n_keys) stop("Invalid key of dictionary values");
+        List ids_words = values[v];
+        if (ids_words.size() == 0) continue;
+        expand_value(ids_words, 0, seq, keys[v], map_seqs, keys_seqs);
+    }
+    TrieSequences trie;
+    for (auto it = map_seqs.begin(); it != map_seqs.end(); ++it) {
+        trie.insert(it->first, it->second + 1);
+    }
+
+    int n_docs = texts.size();
+    std::vector<const int*> ptrs(n_docs);
+    std::vector<std::size_t> lens(n_docs);
+    for (int h = 0; h < n_docs; h++) {
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (std::size_t i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    std::vector<Counts> counts_docs(n_docs);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<int> counter(n_types + n_keys + 1, 0);
+        std::vector<unsigned int> touched;
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            count_keys(ptrs[h], lens[h], trie, keys_seqs, n_types, exclusive,
+                       counter, touched, counts_docs[h]);
+        }
+    }
+
+    return dfm_slots(counts_docs, n_types + n_keys);
+}
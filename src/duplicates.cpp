@@ -0,0 +1,268 @@
+#include "quanteda.h"
+#include "ngrams.h"
+#include "profile.h"
+#include <algorithm>
+#include <limits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Near-duplicate documents are found by MinHash and locality-sensitive
+// hashing: each document is a set of hashed shingles or features, summarized
+// by the minima of several hash functions over the set, and documents whose
+// signatures agree on all the rows of any band are compared.
+
+// Hashes of the shingles or features of a document, sorted and unique
+typedef std::vector<uint64_t> Shingles;
+
+// Signature of a set as the minima of n hash functions given by their seeds
+void minhash(const Shingles &shingles, const std::vector<uint64_t> &seeds, uint32_t *signature) {
+    std::size_t n = seeds.size();
+    std::fill(signature, signature + n, std::numeric_limits<uint32_t>::max());
+    for (std::size_t j = 0; j < shingles.size(); j++) {
+        for (std::size_t k = 0; k < n; k++) {
+            uint32_t h = mix64(shingles[j] ^ seeds[k]) >> 32;
+            if (h < signature[k]) signature[k] = h;
+        }
+    }
+}
+
+// Jaccard similarity of two sorted sets
+double jaccard(const Shingles &a, const Shingles &b) {
+    std::size_t i = 0, j = 0, n = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            n++; i++; j++;
+        }
+    }
+    std::size_t u = a.size() + b.size() - n;
+    return u > 0 ? (double)n / u : 0.0;
+}
+
+// Pairs of documents whose signatures fall in the same bucket of any band,
+// with the proportion of hashes they share, and their exact Jaccard
+// similarity if verify. Pairs are kept if their exact similarity when verified,
+// or their estimated one otherwise, is at least threshold. Empty documents are
+// not paired. The sets are released unless they are needed for verification.
+List near_duplicates(std::vector<Shingles> &sets,
+                     const std::vector<uint32_t> &signatures,
+                     const int n_hashes, const int n_bands,
+                     const double threshold, const bool verify,
+                     const int thread){
+
+    PROFILE_CALL("near_duplicates");
+    int n_docs = sets.size();
+    int n_rows = n_hashes / n_bands;
+    std::vector<char> empty(n_docs);
+    for (int h = 0; h < n_docs; h++) empty[h] = sets[h].empty();
+    if (!verify) std::vector<Shingles>().swap(sets);
+
+    // Documents are bucketed by the hash of their rows in each band, and all
+    // the pairs in a bucket are candidates
+    PROFILE_STAGE("buckets");
+    std::vector< std::vector<uint64_t> > pairs_bands(n_bands);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 1)
+    #endif
+    for (int b = 0; b < n_bands; b++) {
+        std::vector< std::pair<uint64_t, int> > keys;
+        keys.reserve(n_docs);
+        for (int h = 0; h < n_docs; h++) {
+            if (empty[h]) continue;
+            const uint32_t *rows = &signatures[(std::size_t)h * n_hashes + b * n_rows];
+            uint64_t key = b;
+            for (int r = 0; r < n_rows; r++) key = mix64(key ^ rows[r]) + r;
+            keys.push_back(std::make_pair(key, h));
+        }
+        std::sort(keys.begin(), keys.end());
+        std::vector<uint64_t> &pairs = pairs_bands[b];
+        for (std::size_t start = 0; start < keys.size(); ) {
+            std::size_t end = start + 1;
+            while (end < keys.size() && keys[end].first == keys[start].first) end++;
+            for (std::size_t i = start; i < end; i++) {
+                for (std::size_t j = i + 1; j < end; j++) {
+                    pairs.push_back(((uint64_t)keys[i].second << 32) | (uint32_t)keys[j].second);
+                }
+            }
+            start = end;
+        }
+    }
+    std::vector<uint64_t> pairs;
+    for (int b = 0; b < n_bands; b++) {
+        pairs.insert(pairs.end(), pairs_bands[b].begin(), pairs_bands[b].end());
+        std::vector<uint64_t>().swap(pairs_bands[b]);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    PROFILE_COUNT("candidates", pairs.size());
+
+    // Similarities of the candidates
+    PROFILE_STAGE("similarity");
+    std::size_t n_pairs = pairs.size();
+    std::vector<double> estimates(n_pairs), exacts(n_pairs, NA_REAL);
+    std::vector<char> kept(n_pairs);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 256)
+    #endif
+    for (std::size_t p = 0; p < n_pairs; p++) {
+        int i = pairs[p] >> 32, j = pairs[p] & 0xffffffff;
+        const uint32_t *sig_i = &signatures[(std::size_t)i * n_hashes];
+        const uint32_t *sig_j = &signatures[(std::size_t)j * n_hashes];
+        int n = 0;
+        for (int k = 0; k < n_hashes; k++) n += sig_i[k] == sig_j[k];
+        estimates[p] = (double)n / n_hashes;
+        if (verify) {
+            exacts[p] = jaccard(sets[i], sets[j]);
+            kept[p] = exacts[p] >= threshold;
+        } else {
+            kept[p] = estimates[p] >= threshold;
+        }
+    }
+
+    std::size_t n_kept = std::count(kept.begin(), kept.end(), 1);
+    PROFILE_COUNT("pairs", n_kept);
+    IntegerVector docs1(n_kept), docs2(n_kept);
+    NumericVector estimates_kept(n_kept), exacts_kept(n_kept);
+    std::size_t m = 0;
+    for (std::size_t p = 0; p < n_pairs; p++) {
+        if (!kept[p]) continue;
+        docs1[m] = (pairs[p] >> 32) + 1;
+        docs2[m] = (pairs[p] & 0xffffffff) + 1;
+        estimates_kept[m] = estimates[p];
+        exacts_kept[m] = exacts[p];
+        m++;
+    }
+    return List::create(_["i"] = docs1,
+                        _["j"] = docs2,
+                        _["estimate"] = estimates_kept,
+                        _["jaccard"] = exacts_kept);
+}
+
+// Seeds of the hash functions of signatures
+std::vector<uint64_t> minhash_seeds(const int n_hashes, const int seed) {
+    std::vector<uint64_t> seeds(n_hashes);
+    for (int k = 0; k < n_hashes; k++) seeds[k] = mix64((uint64_t)seed * n_hashes + k + 1);
+    return seeds;
+}
+
+// Find near-duplicate documents of hashed tokens, as sets of their shingles of
+// size tokens, formed as ngrams are. Documents shorter than size are a single
+// shingle of all their tokens. Shingles of padding only are ignored.
+// Documents are shingled and signed in parallel.
+// [[Rcpp::export]]
+List duplicates_hashed_cppl(List texts,
+                            const int size,
+                            const int n_hashes,
+                            const int n_bands,
+                            const double threshold,
+                            const bool verify,
+                            const int seed,
+                            const int thread){
+
+    PROFILE_CALL("duplicates_hashed_cppl");
+    if (size < 1 || n_bands < 1 || n_hashes % n_bands != 0) stop("Invalid size of shingles or bands");
+    int n_docs = texts.size();
+    std::vector<const int*> ptrs(n_docs);
+    std::vector<std::size_t> lens(n_docs);
+    for (int h = 0; h < n_docs; h++) {
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+    }
+
+    PROFILE_STAGE("signatures");
+    std::vector<uint64_t> seeds = minhash_seeds(n_hashes, seed);
+    std::vector<Shingles> sets(n_docs);
+    std::vector<uint32_t> signatures((std::size_t)n_docs * n_hashes);
+    std::vector<int> ns(1, size), ks(1, 1);
+    hash_ngram hasher;
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        Text ngram;
+        std::vector<std::size_t> pos, js;
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            Shingles &shingles = sets[h];
+            std::size_t len = lens[h];
+            auto shingle_found = [&](const Text &shingle){
+                for (std::size_t i = 0; i < shingle.size(); i++) {
+                    if (shingle[i] != 0) {
+                        shingles.push_back(hasher(shingle));
+                        return;
+                    }
+                }
+            };
+            if (len < (std::size_t)size) {
+                if (len > 0) shingle_found(Text(ptrs[h], ptrs[h] + len));
+            } else {
+                skipgrams(ptrs[h], len, ns, ks, ngram, pos, js, shingle_found);
+            }
+            std::sort(shingles.begin(), shingles.end());
+            shingles.erase(std::unique(shingles.begin(), shingles.end()), shingles.end());
+            minhash(shingles, seeds, &signatures[(std::size_t)h * n_hashes]);
+            if (!verify && !shingles.empty()) Shingles(1, shingles[0]).swap(shingles); // only emptiness is kept
+        }
+    }
+    PROFILE_COUNT("documents", n_docs);
+    PROFILE_COUNT("hashes", n_hashes);
+    PROFILE_COUNT("bands", n_bands);
+
+    return near_duplicates(sets, signatures, n_hashes, n_bands, threshold, verify, thread);
+}
+
+// Find near-duplicate documents of a dfm given as the slots of a dgCMatrix, as
+// sets of the features they contain. Documents are signed in parallel.
+// [[Rcpp::export]]
+List duplicates_dfm_cppl(const NumericVector &slot_x,
+                         const IntegerVector &slot_i,
+                         const IntegerVector &slot_p,
+                         const int n_docs,
+                         const int n_hashes,
+                         const int n_bands,
+                         const double threshold,
+                         const bool verify,
+                         const int seed,
+                         const int thread){
+
+    PROFILE_CALL("duplicates_dfm_cppl");
+    if (n_bands < 1 || n_hashes % n_bands != 0) stop("Invalid number of bands");
+    int n_cols = slot_p.size() - 1;
+    const double *x = REAL(slot_x);
+    const int *rows = INTEGER(slot_i);
+    const int *ptrs = INTEGER(slot_p);
+    for (int k = 0; k < ptrs[n_cols]; k++) {
+        if (rows[k] < 0 || rows[k] >= n_docs) stop("Invalid row index of a dfm");
+    }
+
+    // Features of each document, in order of columns
+    PROFILE_STAGE("signatures");
+    std::vector<Shingles> sets(n_docs);
+    for (int j = 0; j < n_cols; j++) {
+        for (int k = ptrs[j]; k < ptrs[j + 1]; k++) {
+            if (x[k] > 0) sets[rows[k]].push_back(j);
+        }
+    }
+    std::vector<uint64_t> seeds = minhash_seeds(n_hashes, seed);
+    std::vector<uint32_t> signatures((std::size_t)n_docs * n_hashes);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 16)
+    #endif
+    for (int h = 0; h < n_docs; h++) {
+        minhash(sets[h], seeds, &signatures[(std::size_t)h * n_hashes]);
+    }
+    PROFILE_COUNT("documents", n_docs);
+    PROFILE_COUNT("hashes", n_hashes);
+    PROFILE_COUNT("bands", n_bands);
+
+    return near_duplicates(sets, signatures, n_hashes, n_bands, threshold, verify, thread);
+}
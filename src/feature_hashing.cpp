@@ -0,0 +1,226 @@
+#include "quanteda.h"
+#include "ngrams.h"
+#include "profile.h"
+#include <algorithm>
+#include <numeric>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Hash of a string by 64-bit FNV-1a, mixed so that all its bits are usable
+inline uint64_t hash_string(const std::string &str) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < str.size(); i++) {
+        h ^= (unsigned char)str[i];
+        h *= 0x100000001b3ULL;
+    }
+    return mix64(h);
+}
+
+// Hash of an ngram from the hashes of its types, depending on their order
+inline uint64_t hash_ngram_types(const Text &ngram, const std::vector<uint64_t> &hashes_types) {
+    uint64_t h = ngram.size();
+    for (std::size_t i = 0; i < ngram.size(); i++) h = mix64(h ^ hashes_types[ngram[i]]);
+    return h;
+}
+
+// Sample of distinct features with the lowest priorities, which are hashes of
+// their own, so that the sample does not depend on the order of documents
+class FeatureSample {
+    std::size_t size;
+    std::vector< std::pair<uint64_t, uint64_t> > heap; // priority and hash
+    std::unordered_map<uint64_t, Text> ngrams;
+
+public:
+    explicit FeatureSample(std::size_t size_) : size(size_) {}
+
+    static uint64_t priority(uint64_t h) {
+        return mix64(h ^ 0x5851f42d4c957f2dULL);
+    }
+
+    void add(const Text &ngram, uint64_t h) {
+        if (size == 0) return;
+        uint64_t p = priority(h);
+        if (heap.size() == size && p >= heap.front().first) return;
+        if (ngrams.count(h)) return;
+        if (heap.size() == size) {
+            std::pop_heap(heap.begin(), heap.end());
+            ngrams.erase(heap.back().second);
+            heap.pop_back();
+        }
+        heap.push_back(std::make_pair(p, h));
+        std::push_heap(heap.begin(), heap.end());
+        ngrams.emplace(h, ngram);
+    }
+
+    void merge(const FeatureSample &other) {
+        for (std::size_t j = 0; j < other.heap.size(); j++) {
+            uint64_t h = other.heap[j].second;
+            add(other.ngrams.at(h), h);
+        }
+    }
+
+    std::vector< std::pair<uint64_t, Text> > features() const {
+        std::vector< std::pair<uint64_t, Text> > result;
+        for (std::size_t j = 0; j < heap.size(); j++) {
+            result.push_back(std::make_pair(heap[j].second, ngrams.at(heap[j].second)));
+        }
+        return result;
+    }
+};
+
+// Slots of a dgCMatrix of all the n_cols columns from the counts of documents.
+// Unlike dfm_slots(), no vectors of types are made: only the column pointers
+// take memory by column, 4 bytes each, and they are also used as cursors.
+List hashed_slots(std::vector<Counts> &counts_docs, const std::size_t n_cols) {
+
+    int n_docs = counts_docs.size();
+    IntegerVector slot_p(n_cols + 1);
+    int *p = INTEGER(slot_p);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < counts_docs[h].size(); j++) p[counts_docs[h][j].first]++;
+    }
+    for (std::size_t k = 1; k <= n_cols; k++) p[k] += p[k - 1];
+
+    // Each column is filled from its start, which then moves to the start of
+    // the next column, so the pointers are shifted back afterwards
+    int nnz = p[n_cols];
+    IntegerVector slot_i(nnz);
+    NumericVector slot_x(nnz);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < counts_docs[h].size(); j++) {
+            int k = p[counts_docs[h][j].first - 1]++;
+            slot_i[k] = h;
+            slot_x[k] = counts_docs[h][j].second;
+        }
+        Counts().swap(counts_docs[h]); // release memory as we go
+    }
+    for (std::size_t k = n_cols; k > 0; k--) p[k] = p[k - 1];
+    p[0] = 0;
+
+    return List::create(_["i"] = slot_i,
+                        _["p"] = slot_p,
+                        _["x"] = slot_x);
+}
+
+// Count the ngrams and skipgrams of hashed tokens into 2^bits columns given by
+// the hashes of their types, without indexing the ngrams. With is_signed, each
+// ngram adds 1 or -1 by another bit of its hash. Ngrams of padding only are
+// ignored. Documents are counted in parallel, and a sample of n_sample
+// distinct features is returned for reverse lookup with their columns and
+// signs. Returns the slots of a dgCMatrix of all the columns, which are not
+// named. At most 2^30 columns fit the integer dimensions of a dgCMatrix.
+// [[Rcpp::export]]
+List dfm_feature_hashed_cppl(List texts,
+                             const std::vector<std::string> &types,
+                             const std::vector<int> &ns,
+                             const std::vector<int> &ks,
+                             const int bits,
+                             const bool is_signed,
+                             const int n_sample,
+                             const std::string &delim,
+                             const int thread){
+
+    PROFILE_CALL("dfm_feature_hashed_cppl");
+    if (bits < 1 || bits > 30) stop("Invalid number of bits");
+    if (n_sample < 0) stop("Invalid size of sample");
+    int n_types = types.size();
+    int n_docs = texts.size();
+    std::vector<const int*> ptrs(n_docs);
+    std::vector<std::size_t> lens(n_docs);
+    for (int h = 0; h < n_docs; h++) {
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (std::size_t i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    // Types are hashed once, padding as the empty string
+    PROFILE_STAGE("types");
+    std::vector<uint64_t> hashes_types(n_types + 1, hash_string(""));
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(static)
+    #endif
+    for (int g = 0; g < n_types; g++) hashes_types[g + 1] = hash_string(types[g]);
+
+    PROFILE_STAGE("count");
+    const uint64_t mask = ((uint64_t)1 << bits) - 1;
+    std::vector<Counts> counts_docs(n_docs);
+    FeatureSample sample(n_sample);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        Text ngram;
+        std::vector<std::size_t> pos, js;
+        std::vector< std::pair<unsigned int, int> > cols;
+        FeatureSample sample_local(n_sample);
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            cols.clear();
+            skipgrams(ptrs[h], lens[h], ns, ks, ngram, pos, js,
+                      [&](const Text &skipgram){
+                          if (std::count(skipgram.begin(), skipgram.end(), 0) == (long)skipgram.size()) return;
+                          uint64_t hash = hash_ngram_types(skipgram, hashes_types);
+                          int sign = is_signed && (hash >> 63) ? -1 : 1;
+                          cols.push_back(std::make_pair((unsigned int)(hash & mask) + 1, sign));
+                          sample_local.add(skipgram, hash);
+                      });
+            std::sort(cols.begin(), cols.end());
+            Counts &counts = counts_docs[h];
+            for (std::size_t j = 0; j < cols.size(); j++) {
+                if (!counts.empty() && counts.back().first == cols[j].first) {
+                    counts.back().second += cols[j].second;
+                } else {
+                    counts.push_back(cols[j]);
+                }
+            }
+            // signed counts of colliding features can cancel out
+            counts.erase(std::remove_if(counts.begin(), counts.end(),
+                                        [](const Count &c){ return c.second == 0; }),
+                         counts.end());
+        }
+        #ifdef _OPENMP
+        #pragma omp critical
+        #endif
+        sample.merge(sample_local);
+    }
+    PROFILE_COUNT("documents", n_docs);
+    PROFILE_COUNT("tokens", std::accumulate(lens.begin(), lens.end(), 0.0));
+    PROFILE_COUNT("types", n_types);
+    PROFILE_COUNT("columns", mask + 1);
+
+    PROFILE_STAGE("slots");
+    List slots = hashed_slots(counts_docs, mask + 1);
+    PROFILE_COUNT("nonzero", Rf_length(slots["x"]));
+
+    // Sampled features sorted by column, joined as ngrams are
+    std::vector< std::pair<uint64_t, Text> > features = sample.features();
+    std::sort(features.begin(), features.end(),
+              [&](const std::pair<uint64_t, Text> &a, const std::pair<uint64_t, Text> &b){
+                  return (a.first & mask) < (b.first & mask) ||
+                      ((a.first & mask) == (b.first & mask) && a.first < b.first);
+              });
+    std::size_t n_features = features.size();
+    std::vector<std::string> strs(n_features);
+    IntegerVector columns(n_features), signs(n_features);
+    for (std::size_t j = 0; j < n_features; j++) {
+        const Text &ngram = features[j].second;
+        for (std::size_t i = 0; i < ngram.size(); i++) {
+            if (i > 0) strs[j] += delim;
+            if (ngram[i] > 0) strs[j] += types[ngram[i] - 1];
+        }
+        columns[j] = (features[j].first & mask) + 1;
+        signs[j] = is_signed && (features[j].first >> 63) ? -1 : 1;
+    }
+    slots["lookup"] = List::create(_["feature"] = as_utf8(strs),
+                                   _["column"] = columns,
+                                   _["sign"] = signs);
+    return slots;
+}
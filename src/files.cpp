@@ -0,0 +1,431 @@
+#include "quanteda.h"
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Binary files of tokens and of sparse dfms start with a header of 64 bytes.
+// Numbers are written in the byte order of the machine, which is checked by
+// the field check when files are read.
+//
+// Tokens file: header, token IDs (int32) of all documents, offsets (uint64)
+// of the first token of each document and of the end, then strings prefixed
+// by their length (uint32): the types, the document names, and the "what",
+// "ngrams" and "concatenator" attributes.
+//
+// Dfm file: header, the p (int32), i (int32) and x (double) slots of a
+// dgCMatrix, then the document names and the features as strings.
+struct FileHeader {
+    char magic[8];
+    uint64_t check;
+    uint64_t n1; // documents, or rows
+    uint64_t n2; // tokens, or columns
+    uint64_t n3; // types, or non-zero values
+    uint64_t pos1; // offsets, or i
+    uint64_t pos2; // strings, or x
+    uint64_t pos3; // end of file, or strings
+};
+
+const char MAGIC_TOKENS[8] = {'Q', 'T', 'O', 'K', 'E', 'N', 'S', '1'};
+const char MAGIC_DFM[8] = {'Q', 'D', 'F', 'M', 'S', 'P', 'R', '1'};
+const uint64_t CHECK = 0x0102030405060708;
+const std::size_t N_META = 3;
+
+// A file mapped read-only into memory, unmapped when it goes out of scope
+class MappedFile {
+    const char *data_;
+    std::size_t size_;
+#ifdef _WIN32
+    HANDLE file_, map_;
+#endif
+
+public:
+    MappedFile(const std::string &path) : data_(NULL), size_(0) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open " + path);
+        LARGE_INTEGER size;
+        GetFileSizeEx(file_, &size);
+        size_ = size.QuadPart;
+        map_ = CreateFileMapping(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (map_ == NULL) {
+            CloseHandle(file_);
+            throw std::runtime_error("Cannot map " + path);
+        }
+        data_ = (const char*)MapViewOfFile(map_, FILE_MAP_READ, 0, 0, 0);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) throw std::runtime_error("Cannot open " + path);
+        struct stat st;
+        fstat(fd, &st);
+        size_ = st.st_size;
+        if (size_ == 0) {
+            close(fd);
+            throw std::runtime_error("Empty file " + path);
+        }
+        void *data = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) throw std::runtime_error("Cannot map " + path);
+        data_ = (const char*)data;
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        CloseHandle(map_);
+        CloseHandle(file_);
+#else
+        if (data_) munmap((void*)data_, size_);
+#endif
+    }
+
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+};
+
+FileHeader read_header(const MappedFile &file, const char *magic){
+    FileHeader header;
+    if (file.size() < sizeof(FileHeader)) stop("Not a quanteda binary file");
+    std::memcpy(&header, file.data(), sizeof(FileHeader));
+    const char blank[8] = {0};
+    if (std::memcmp(header.magic, blank, 8) == 0) stop("The file is incomplete, as its writing was interrupted");
+    if (std::memcmp(header.magic, magic, 8) != 0) stop("Not a quanteda binary file of this kind");
+    if (header.check != CHECK) stop("The file was written on a machine of different byte order");
+    return header;
+}
+
+// Read n strings prefixed by their length starting at pos, which is moved to
+// the end of the last
+std::vector<std::string> read_strings(const MappedFile &file, uint64_t &pos, const std::size_t n){
+    std::vector<std::string> strs(n);
+    for (std::size_t k = 0; k < n; k++) {
+        uint32_t len;
+        if (pos + sizeof(len) > file.size()) stop("The file is truncated");
+        std::memcpy(&len, file.data() + pos, sizeof(len));
+        pos += sizeof(len);
+        if (pos + len > file.size()) stop("The file is truncated");
+        strs[k].assign(file.data() + pos, len);
+        pos += len;
+    }
+    return strs;
+}
+
+void write_strings(std::ostream &out, const std::vector<std::string> &strs){
+    for (std::size_t k = 0; k < strs.size(); k++) {
+        uint32_t len = strs[k].size();
+        out.write((const char*)&len, sizeof(len));
+        out.write(strs[k].data(), len);
+    }
+}
+
+std::vector<std::string> as_strings(const CharacterVector &strs){
+    std::vector<std::string> result(strs.size());
+    for (int k = 0; k < strs.size(); k++) {
+        if (STRING_ELT(strs, k) == NA_STRING) continue;
+        result[k] = Rf_translateCharUTF8(STRING_ELT(strs, k));
+    }
+    return result;
+}
+
+// Contents of a tokens file other than its tokens
+struct TokensIndex {
+    FileHeader header;
+    std::vector<uint64_t> offsets;
+    std::vector<std::string> types, docnames, meta;
+};
+
+TokensIndex read_index(const MappedFile &file){
+    TokensIndex index;
+    index.header = read_header(file, MAGIC_TOKENS);
+    const FileHeader &header = index.header;
+    if (header.pos3 > file.size() || header.pos1 + (header.n1 + 1) * sizeof(uint64_t) > file.size())
+        stop("The file is truncated");
+    index.offsets.resize(header.n1 + 1);
+    std::memcpy(index.offsets.data(), file.data() + header.pos1, (header.n1 + 1) * sizeof(uint64_t));
+    uint64_t pos = header.pos2;
+    index.types = read_strings(file, pos, header.n3);
+    index.docnames = read_strings(file, pos, header.n1);
+    index.meta = read_strings(file, pos, N_META);
+    return index;
+}
+
+// Write hashed tokens to a binary file, or append them to the documents of an
+// existing file. Appended tokens are recoded to the types of the file, adding
+// the types not yet in it, so documents can be written in chunks hashed
+// separately.
+// [[Rcpp::export]]
+void write_tokens_cpp(List texts,
+                      const CharacterVector &types_,
+                      const CharacterVector &docnames_,
+                      const CharacterVector &meta_,
+                      const std::string &path,
+                      const bool append){
+
+    TokensIndex index;
+    if (append) {
+        MappedFile file(path);
+        index = read_index(file);
+    } else {
+        index.offsets.push_back(0);
+        index.meta = as_strings(meta_);
+        if (index.meta.size() != N_META) stop("Invalid attributes of tokens");
+    }
+
+    std::unordered_map<std::string, unsigned int> map_types;
+    for (std::size_t g = 0; g < index.types.size(); g++) {
+        map_types.emplace(index.types[g], g + 1);
+    }
+    std::vector<std::string> types = as_strings(types_);
+    std::vector<unsigned int> ids(types.size() + 1, 0);
+    for (std::size_t g = 0; g < types.size(); g++) {
+        auto it = map_types.emplace(types[g], index.types.size() + 1);
+        if (it.second) index.types.push_back(types[g]);
+        ids[g + 1] = it.first->second;
+    }
+
+    // Tokens are checked before anything is written, so that invalid tokens
+    // leave a file appended to unchanged
+    std::vector<std::string> docnames = as_strings(docnames_);
+    if ((int)docnames.size() != texts.size()) stop("There must be a name for each document");
+    for (int h = 0; h < texts.size(); h++) {
+        if (TYPEOF(texts[h]) != INTSXP) stop("Each element of the list must be an integer vector");
+        SEXP text = texts[h];
+        const int *ptr = INTEGER(text);
+        for (int i = 0; i < LENGTH(text); i++) {
+            if (ptr[i] < 0 || ptr[i] > (int)types.size()) stop("Invalid type ID in tokens");
+        }
+    }
+
+    // Appended tokens overwrite the index of the file, so the header is blanked
+    // until the new index is written, and a file whose writing is interrupted
+    // is then reported as incomplete rather than read with a wrong index
+    std::fstream out;
+    uint64_t pos_tokens = sizeof(FileHeader);
+    if (append) {
+        out.open(path.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        pos_tokens = index.header.pos1;
+    } else {
+        out.open(path.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    }
+    if (!out) stop("Cannot open " + path);
+    FileHeader blank;
+    std::memset(&blank, 0, sizeof(FileHeader));
+    out.write((const char*)&blank, sizeof(FileHeader));
+    out.flush();
+    out.seekp(pos_tokens);
+
+    std::vector<int32_t> buffer;
+    for (int h = 0; h < texts.size(); h++) {
+        SEXP text = texts[h];
+        const int *ptr = INTEGER(text);
+        std::size_t len = LENGTH(text);
+        buffer.resize(len);
+        for (std::size_t i = 0; i < len; i++) buffer[i] = ids[ptr[i]];
+        out.write((const char*)buffer.data(), buffer.size() * sizeof(int32_t));
+        index.offsets.push_back(index.offsets.back() + buffer.size());
+        index.docnames.push_back(docnames[h]);
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC_TOKENS, 8);
+    header.check = CHECK;
+    header.n1 = index.docnames.size();
+    header.n2 = index.offsets.back();
+    header.n3 = index.types.size();
+    header.pos1 = sizeof(FileHeader) + header.n2 * sizeof(int32_t);
+    out.write((const char*)index.offsets.data(), index.offsets.size() * sizeof(uint64_t));
+    header.pos2 = header.pos1 + index.offsets.size() * sizeof(uint64_t);
+    write_strings(out, index.types);
+    write_strings(out, index.docnames);
+    write_strings(out, index.meta);
+    header.pos3 = out.tellp();
+    out.flush(); // the index is written before the header that points to it
+    out.seekp(0);
+    out.write((const char*)&header, sizeof(FileHeader));
+    if (!out) stop("Cannot write " + path);
+}
+
+// Read the types, document names and attributes of a tokens file
+// [[Rcpp::export]]
+List read_tokens_index_cpp(const std::string &path){
+    MappedFile file(path);
+    TokensIndex index = read_index(file);
+    return List::create(_["ntoken"] = (double)index.header.n2,
+                        _["types"] = as_utf8(index.types),
+                        _["docnames"] = as_utf8(index.docnames),
+                        _["meta"] = as_utf8(index.meta));
+}
+
+// Read the tokens of documents (1-based) from a tokens file; only the pages of
+// the documents read are loaded from disk
+// [[Rcpp::export]]
+List read_tokens_cpp(const std::string &path, const std::vector<int> &docs){
+    MappedFile file(path);
+    TokensIndex index = read_index(file);
+    const int32_t *tokens = (const int32_t*)(file.data() + sizeof(FileHeader));
+    List texts(docs.size());
+    for (std::size_t k = 0; k < docs.size(); k++) {
+        if (docs[k] < 1 || docs[k] > (int)index.header.n1) stop("Invalid document index");
+        uint64_t from = index.offsets[docs[k] - 1], to = index.offsets[docs[k]];
+        texts[k] = IntegerVector(tokens + from, tokens + to);
+    }
+    return texts;
+}
+
+// Count the tokens of all documents of a tokens file in parallel, reading
+// them from the mapped file rather than from R. Type g is counted as type
+// ids_new[g - 1], or is not counted if 0, so that types can be selected and
+// merged before counting. Returns the slots of a dgCMatrix as
+// dfm_hashed_cppl() does.
+// [[Rcpp::export]]
+List dfm_tokens_file_cppl(const std::string &path,
+                          const std::vector<int> &ids_new,
+                          const int n_new,
+                          const int thread){
+    MappedFile file(path);
+    TokensIndex index = read_index(file);
+    std::size_t n_types = index.types.size();
+    if (ids_new.size() != n_types) stop("There must be a new ID for each type");
+    std::vector<unsigned int> map_ids(n_types + 1, 0);
+    for (std::size_t g = 0; g < n_types; g++) {
+        if (ids_new[g] < 0 || ids_new[g] > n_new) stop("Invalid new type ID");
+        map_ids[g + 1] = ids_new[g];
+    }
+
+    const int32_t *tokens = (const int32_t*)(file.data() + sizeof(FileHeader));
+    int n_docs = index.header.n1;
+    std::vector<Counts> counts_docs(n_docs);
+    bool invalid = false;
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<int> counter(n_new + 1, 0);
+        std::vector<unsigned int> touched;
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            touched.clear();
+            for (uint64_t i = index.offsets[h]; i < index.offsets[h + 1]; i++) {
+                if (tokens[i] < 0 || (std::size_t)tokens[i] > n_types) {
+                    invalid = true;
+                    break;
+                }
+                unsigned int id = map_ids[tokens[i]];
+                if (id == 0) continue;
+                if (counter[id]++ == 0) touched.push_back(id);
+            }
+            Counts &counts = counts_docs[h];
+            counts.reserve(touched.size());
+            for (std::size_t j = 0; j < touched.size(); j++) {
+                counts.push_back(std::make_pair(touched[j], counter[touched[j]]));
+                counter[touched[j]] = 0;
+            }
+        }
+    }
+    if (invalid) stop("Invalid type ID in the file");
+
+    return dfm_slots(counts_docs, n_new);
+}
+
+// Contents of a dfm file other than its slots
+struct DfmIndex {
+    FileHeader header;
+    std::vector<std::string> docnames, features;
+};
+
+// Write the slots and names of a dgCMatrix to a binary file
+// [[Rcpp::export]]
+void write_dfm_cpp(const IntegerVector &slot_i, const IntegerVector &slot_p,
+                   const NumericVector &slot_x, const int n_rows, const int n_cols,
+                   const CharacterVector &docnames, const CharacterVector &features,
+                   const std::string &path){
+
+    if (slot_p.size() != n_cols + 1 || slot_i.size() != slot_x.size())
+        stop("Invalid slots of dgCMatrix");
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC_DFM, 8);
+    header.check = CHECK;
+    header.n1 = n_rows;
+    header.n2 = n_cols;
+    header.n3 = slot_x.size();
+    header.pos1 = sizeof(FileHeader) + (n_cols + 1) * sizeof(int32_t);
+    header.pos2 = header.pos1 + header.n3 * sizeof(int32_t);
+    header.pos2 += (sizeof(double) - header.pos2 % sizeof(double)) % sizeof(double); // aligned
+    header.pos3 = header.pos2 + header.n3 * sizeof(double);
+
+    std::ofstream out(path.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out) stop("Cannot open " + path);
+    out.write((const char*)&header, sizeof(FileHeader));
+    out.write((const char*)slot_p.begin(), (n_cols + 1) * sizeof(int32_t));
+    out.write((const char*)slot_i.begin(), header.n3 * sizeof(int32_t));
+    out.seekp(header.pos2);
+    out.write((const char*)slot_x.begin(), header.n3 * sizeof(double));
+    write_strings(out, as_strings(docnames));
+    write_strings(out, as_strings(features));
+    if (!out) stop("Cannot write " + path);
+}
+
+DfmIndex read_dfm_index(const MappedFile &file){
+    DfmIndex index;
+    index.header = read_header(file, MAGIC_DFM);
+    if (index.header.pos3 > file.size()) stop("The file is truncated");
+    uint64_t pos = index.header.pos3;
+    index.docnames = read_strings(file, pos, index.header.n1);
+    index.features = read_strings(file, pos, index.header.n2);
+    return index;
+}
+
+// Read the document names and features of a dfm file
+// [[Rcpp::export]]
+List read_dfm_index_cpp(const std::string &path){
+    MappedFile file(path);
+    DfmIndex index = read_dfm_index(file);
+    return List::create(_["docnames"] = as_utf8(index.docnames),
+                        _["features"] = as_utf8(index.features));
+}
+
+// Read the slots of a dgCMatrix from a binary file, only for the columns
+// given (1-based), so that features can be read without the rest
+// [[Rcpp::export]]
+List read_dfm_cpp(const std::string &path, const std::vector<int> &cols){
+    MappedFile file(path);
+    DfmIndex index = read_dfm_index(file);
+    const FileHeader &header = index.header;
+    int n_cols = header.n2;
+    const int32_t *p = (const int32_t*)(file.data() + sizeof(FileHeader));
+    const int32_t *i = (const int32_t*)(file.data() + header.pos1);
+    const double *x = (const double*)(file.data() + header.pos2);
+
+    std::size_t nnz = 0;
+    for (std::size_t k = 0; k < cols.size(); k++) {
+        if (cols[k] < 1 || cols[k] > n_cols) stop("Invalid column index");
+        nnz += p[cols[k]] - p[cols[k] - 1];
+    }
+    IntegerVector slot_p(cols.size() + 1), slot_i(nnz);
+    NumericVector slot_x(nnz);
+    std::size_t j = 0;
+    for (std::size_t k = 0; k < cols.size(); k++) {
+        int32_t from = p[cols[k] - 1], to = p[cols[k]];
+        std::copy(i + from, i + to, slot_i.begin() + j);
+        std::copy(x + from, x + to, slot_x.begin() + j);
+        j += to - from;
+        slot_p[k + 1] = j;
+    }
+    return List::create(_["i"] = slot_i, _["p"] = slot_p, _["x"] = slot_x);
+}
@@ -0,0 +1,111 @@
+#include "quanteda.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Positions at which a sequence of keywords starts in a document. Each keyword
+// is the set of types it matches, flagged in a table of the types.
+void match_keywords(const int *text, const std::size_t len_text,
+                    const std::vector< std::vector<char> > &flags,
+                    std::vector<int> &starts){
+    std::size_t len_keys = flags.size();
+    if (len_text < len_keys) return;
+    for (std::size_t i = 0; i <= len_text - len_keys; i++) {
+        std::size_t j = 0;
+        while (j < len_keys && flags[j][text[i + j]]) j++;
+        if (j == len_keys) starts.push_back(i);
+    }
+}
+
+// Join the types of tokens from..to - 1 by spaces; padding is an empty string
+std::string join_types(const int *text, const std::size_t from, const std::size_t to,
+                       const std::vector<std::string> &types){
+    std::string joined;
+    for (std::size_t i = from; i < to; i++) {
+        if (i > from) joined += " ";
+        if (text[i] > 0) joined += types[text[i] - 1];
+    }
+    return joined;
+}
+
+// Find sequences of keywords in hashed tokens and return the document, the
+// start of the match and its context for all matches as columns. The
+// keywords are given as the IDs of the types matched by each of them, so
+// that patterns are only resolved once against the types.
+// [[Rcpp::export]]
+List kwic_hashed_cppl(List texts,
+                      const std::vector<std::string> &types,
+                      const List &keywords,
+                      const int window,
+                      const int thread){
+
+    int n_types = types.size();
+    std::size_t len_keys = keywords.size();
+    std::vector< std::vector<char> > flags(len_keys, std::vector<char>(n_types + 1, false));
+    for (std::size_t j = 0; j < len_keys; j++) {
+        std::vector<int> ids = as< std::vector<int> >(keywords[j]);
+        for (std::size_t g = 0; g < ids.size(); g++) {
+            if (ids[g] < 1 || ids[g] > n_types) stop("Invalid type ID in keywords");
+            flags[j][ids[g]] = true;
+        }
+    }
+
+    int len = texts.size();
+    std::vector<const int*> ptrs(len);
+    std::vector<std::size_t> lens(len);
+    for (int h = 0; h < len; h++) {
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (std::size_t i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    // Documents are searched and contexts joined in parallel
+    std::vector< std::vector<int> > starts(len);
+    std::vector< std::vector<std::string> > pre(len), keys(len), post(len);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 16)
+    #endif
+    for (int h = 0; h < len; h++) {
+        match_keywords(ptrs[h], lens[h], flags, starts[h]);
+        std::size_t n_matches = starts[h].size();
+        pre[h].reserve(n_matches);
+        keys[h].reserve(n_matches);
+        post[h].reserve(n_matches);
+        for (std::size_t m = 0; m < n_matches; m++) {
+            std::size_t start = starts[h][m];
+            std::size_t end = start + len_keys;
+            std::size_t from = (start > (std::size_t)window) ? start - window : 0;
+            std::size_t to = std::min(end + window, lens[h]);
+            pre[h].push_back(join_types(ptrs[h], from, start, types));
+            keys[h].push_back(join_types(ptrs[h], start, end, types));
+            post[h].push_back(join_types(ptrs[h], end, to, types));
+        }
+    }
+
+    // Columns are allocated once for all matches
+    std::size_t n = 0;
+    for (int h = 0; h < len; h++) n += starts[h].size();
+    IntegerVector docs_all(n), starts_all(n);
+    CharacterVector pre_all(n), keys_all(n), post_all(n);
+    std::size_t k = 0;
+    for (int h = 0; h < len; h++) {
+        for (std::size_t m = 0; m < starts[h].size(); m++) {
+            docs_all[k] = h + 1;
+            starts_all[k] = starts[h][m] + 1;
+            SET_STRING_ELT(pre_all, k, Rf_mkCharCE(pre[h][m].c_str(), CE_UTF8));
+            SET_STRING_ELT(keys_all, k, Rf_mkCharCE(keys[h][m].c_str(), CE_UTF8));
+            SET_STRING_ELT(post_all, k, Rf_mkCharCE(post[h][m].c_str(), CE_UTF8));
+            k++;
+        }
+    }
+    return List::create(_["docname"] = docs_all,
+                        _["position"] = starts_all,
+                        _["contextPre"] = pre_all,
+                        _["keyword"] = keys_all,
+                        _["contextPost"] = post_all);
+}
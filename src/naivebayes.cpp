@@ -0,0 +1,162 @@
+#include "quanteda.h"
+#include <cmath>
+#include <limits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Count features by class in one pass over the columns of a dfm given as the
+// slots of a dgCMatrix. Rows of class -1 are not in the training set. Columns
+// are counted in parallel, each into its own column of the class x feature
+// matrix. With bernoulli, each feature is counted once per document.
+// [[Rcpp::export]]
+NumericMatrix nb_train_cppl(const std::vector<int> &slot_i,
+                            const std::vector<int> &slot_p,
+                            const std::vector<double> &slot_x,
+                            const std::vector<int> &classes,
+                            const int n_classes,
+                            const bool bernoulli,
+                            const int thread){
+
+    int n_features = slot_p.size() - 1;
+    int n_docs = classes.size();
+    for (std::size_t k = 0; k < slot_i.size(); k++) {
+        if (slot_i[k] < 0 || slot_i[k] >= n_docs) stop("Invalid row index of a dfm");
+    }
+    for (int h = 0; h < n_docs; h++) {
+        if (classes[h] < -1 || classes[h] >= n_classes) stop("Invalid class");
+    }
+
+    NumericMatrix result(n_classes, n_features);
+    double *counts = REAL(result);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 256)
+    #endif
+    for (int j = 0; j < n_features; j++) {
+        double *col = &counts[(std::size_t)j * n_classes];
+        for (int k = slot_p[j]; k < slot_p[j + 1]; k++) {
+            int c = classes[slot_i[k]];
+            if (c < 0 || slot_x[k] == 0) continue;
+            col[c] += bernoulli ? 1 : slot_x[k];
+        }
+    }
+
+    return result;
+}
+
+// Predict classes of documents given as the slots of a dgCMatrix, from the
+// log likelihoods of features by class and the log priors. Documents are taken
+// in blocks of rows: the counts of a block are turned into rows, following a
+// cursor in each column, and its documents are then scored in parallel, each
+// writing its own row of the results, so that neither a copy of the whole dfm
+// nor a temporary matrix of documents by classes is made. Features of ID 0 in
+// features are not in the model. Posteriors are normalized by log-sum-exp;
+// documents with zero likelihood in every class are predicted NA, with NA
+// posteriors.
+// [[Rcpp::export]]
+List nb_predict_cppl(const std::vector<int> &slot_i,
+                     const std::vector<int> &slot_p,
+                     const std::vector<double> &slot_x,
+                     const int n_docs,
+                     const std::vector<int> &features,
+                     const NumericMatrix &log_lik,
+                     const std::vector<double> &log_prior,
+                     const bool bernoulli,
+                     const int thread){
+
+    int n_classes = log_lik.nrow();
+    int n_features = log_lik.ncol();
+    int n_cols = slot_p.size() - 1;
+    if ((int)features.size() != n_cols) stop("Invalid features");
+    if ((int)log_prior.size() != n_classes) stop("Invalid priors");
+    for (int j = 0; j < n_cols; j++) {
+        if (features[j] < 0 || features[j] > n_features) stop("Invalid features");
+    }
+    for (std::size_t k = 0; k < slot_i.size(); k++) {
+        if (slot_i[k] < 0 || slot_i[k] >= n_docs) stop("Invalid row index of a dfm");
+    }
+    std::vector<double> lik(log_lik.begin(), log_lik.end());
+
+    // Results are allocated once and written directly by each thread
+    NumericMatrix log_post_(n_docs, n_classes);
+    NumericMatrix prob_(n_docs, n_classes);
+    IntegerVector predicted_(n_docs);
+    double *log_post = REAL(log_post_);
+    double *prob = REAL(prob_);
+    int *predicted = INTEGER(predicted_);
+    const int na = NA_INTEGER;
+
+    const int block = 4096;
+    std::vector<int> cursors(slot_p.begin(), slot_p.end() - 1);
+    std::vector<int> rows(block + 1), cols;
+    std::vector<double> vals;
+    for (int h0 = 0; h0 < n_docs; h0 += block) {
+        int h1 = std::min(h0 + block, n_docs);
+
+        // Rows of features in the model and their counts; row indices are
+        // sorted in each column, so the cursors only move forward
+        std::fill(rows.begin(), rows.end(), 0);
+        for (int j = 0; j < n_cols; j++) {
+            if (features[j] == 0) continue;
+            for (int k = cursors[j]; k < slot_p[j + 1] && slot_i[k] < h1; k++) rows[slot_i[k] - h0 + 1]++;
+        }
+        for (int h = 0; h < h1 - h0; h++) rows[h + 1] += rows[h];
+        cols.resize(rows[h1 - h0]);
+        vals.resize(rows[h1 - h0]);
+        std::vector<int> pos(rows.begin(), rows.begin() + (h1 - h0));
+        for (int j = 0; j < n_cols; j++) {
+            int k = cursors[j];
+            for (; k < slot_p[j + 1] && slot_i[k] < h1; k++) {
+                if (features[j] == 0) continue;
+                int m = pos[slot_i[k] - h0]++;
+                cols[m] = features[j] - 1;
+                vals[m] = bernoulli ? (slot_x[k] != 0) : slot_x[k];
+            }
+            cursors[j] = k;
+        }
+
+        #ifdef _OPENMP
+        #pragma omp parallel num_threads(thread)
+        #endif
+        {
+            std::vector<double> lp(n_classes);
+            #ifdef _OPENMP
+            #pragma omp for schedule(dynamic, 256)
+            #endif
+            for (int h = h0; h < h1; h++) {
+                lp = log_prior;
+                for (int m = rows[h - h0]; m < rows[h - h0 + 1]; m++) {
+                    if (vals[m] == 0) continue;
+                    const double *col = &lik[(std::size_t)cols[m] * n_classes];
+                    for (int c = 0; c < n_classes; c++) lp[c] += vals[m] * col[c];
+                }
+                int c_max = -1;
+                double lp_max = -std::numeric_limits<double>::infinity();
+                for (int c = 0; c < n_classes; c++) {
+                    if (lp[c] > lp_max) {
+                        lp_max = lp[c];
+                        c_max = c;
+                    }
+                }
+                for (int c = 0; c < n_classes; c++) log_post[(std::size_t)c * n_docs + h] = lp[c];
+                if (c_max < 0) {
+                    // zero likelihood in every class, so no class is more probable
+                    for (int c = 0; c < n_classes; c++) prob[(std::size_t)c * n_docs + h] = NA_REAL;
+                    predicted[h] = na;
+                    continue;
+                }
+                double sum = 0;
+                for (int c = 0; c < n_classes; c++) sum += std::exp(lp[c] - lp_max);
+                double lse = lp_max + std::log(sum);
+                for (int c = 0; c < n_classes; c++) prob[(std::size_t)c * n_docs + h] = std::exp(lp[c] - lse);
+                predicted[h] = c_max + 1;
+            }
+        }
+    }
+
+    return List::create(_["log.posterior.lik"] = log_post_,
+                        _["posterior.prob"] = prob_,
+                        _["nb.predicted"] = predicted_);
+}
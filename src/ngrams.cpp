@@ -1,74 +1,196 @@
 #include <Rcpp.h>
 #include <string>
 #include <algorithm>
+#include "quanteda.h"
+#include "ngrams.h"
 
 using namespace Rcpp;
 using namespace std;
 
-std::string join(std::vector< std::string > ngram, 
-                 std::string delim){
-    if(ngram.size() == 0) return "";
-    std::string token_ngram = ngram[0];
-    int len_ngram = ngram.size();
-    for (int i = 1; i < len_ngram; i++) {
-        token_ngram = token_ngram + delim + ngram[i];
+// IDs given to distinct ngrams in order of appearance. A unigram of padding
+// remains padding.
+class NgramIndex {
+    MapNgrams map_ngrams;
+
+public:
+    Texts ngrams;
+
+    unsigned int id(const Text &ngram) {
+        if (ngram.size() == 1 && ngram[0] == 0) return 0;
+        auto it = map_ngrams.find(ngram);
+        if (it != map_ngrams.end()) return it->second;
+        ngrams.push_back(ngram);
+        map_ngrams.emplace(ngram, ngrams.size());
+        return ngrams.size();
     }
-    return token_ngram;
-}
+};
 
+// Join the types of ngrams once for each ngram, making each string in a buffer
+// of the exact size. Different ngrams can make the same string if types contain
+// the delimiter, so ids_joined gives the ID of the first of such ngrams.
+std::vector<std::string> join_ngrams(const Texts &ngrams,
+                                     const std::vector<std::string> &types,
+                                     const std::string &delim,
+                                     std::vector<unsigned int> &ids_joined){
 
-void skip(std::vector< std::string > &tokens,
-          unsigned int start,
-          unsigned int n, 
-          std::vector< int > ks,
-          std::vector<std::string> ngram,
-          std::vector< std::vector<std::string> > &ngrams
-){
-    
-    int len_tokens = tokens.size();
-    int len_ks = ks.size();
-    
-    ngram.push_back(tokens[start]);
-    if(ngram.size() < n){
-        for (int j = 0; j < len_ks; j++){
-            int next = start + ks[j];
-            if(next > len_tokens - 1) break;
-            skip(tokens, next, n, ks, ngram, ngrams);
+    std::vector<std::string> types_ngram;
+    types_ngram.reserve(ngrams.size());
+    std::unordered_map<std::string, unsigned int> map_joined;
+    map_joined.reserve(ngrams.size());
+    ids_joined.resize(ngrams.size() + 1);
+    ids_joined[0] = 0;
+    for (std::size_t k = 0; k < ngrams.size(); k++) {
+        const Text &ngram = ngrams[k];
+        std::size_t len = delim.size() * (ngram.size() - 1);
+        for (std::size_t j = 0; j < ngram.size(); j++) {
+            if (ngram[j] > 0) len += types[ngram[j] - 1].size();
         }
-    }else{
-        ngrams.push_back(ngram);
+        std::string type_ngram;
+        type_ngram.reserve(len);
+        for (std::size_t j = 0; j < ngram.size(); j++) {
+            if (j > 0) type_ngram += delim;
+            if (ngram[j] > 0) type_ngram += types[ngram[j] - 1]; // padding is an empty string
+        }
+        auto it = map_joined.emplace(type_ngram, types_ngram.size() + 1);
+        if (it.second) types_ngram.push_back(type_ngram);
+        ids_joined[k + 1] = it.first->second;
     }
+    return types_ngram;
 }
 
 // [[Rcpp::export]]
-StringVector skipgramcpp(std::vector < std::string > tokens,
-                         std::vector < int > ns, 
-                         std::vector < int > ks, 
-                         std::string delim) {
-    
-    // Generate skipgrams recursively
-    std::vector<std::string> ngram;
-    std::vector< std::vector<std::string> > ngrams; // For the recursive function
-    int len_ns = ns.size();
-    int len_tokens = tokens.size();
-    
-    for (int g = 0; g < len_ns; g++) {
-        int n = ns[g];
-        for (int h = 0; h < len_tokens; h++) {
-            skip(tokens, h, n, ks, ngram, ngrams); // Get ngrams as reference
-        }
+StringVector skipgramcpp(const CharacterVector &tokens,
+                         const std::vector<int> &ns,
+                         const std::vector<int> &ks,
+                         const std::string &delim) {
+
+    // Index tokens by their types
+    std::unordered_map<std::string, int> map_types;
+    std::vector<std::string> types;
+    std::vector<int> tokens_hashed(tokens.size());
+    for (int i = 0; i < tokens.size(); i++) {
+        auto it = map_types.emplace(Rf_translateCharUTF8(STRING_ELT(tokens, i)), types.size() + 1);
+        if (it.second) types.push_back(it.first->first);
+        tokens_hashed[i] = it.first->second;
     }
-    
-    // Join elements of ngrams
-    StringVector tokens_ngram;
-    int len_ngrams = ngrams.size();
-    for (int h = 0; h < len_ngrams; h++) {
-        Rcpp::String str(join(ngrams[h], delim));
-        str.set_encoding(CE_UTF8);
-        tokens_ngram.push_back(str);
+
+    // Generate skipgrams of IDs
+    NgramIndex index;
+    Text ngram;
+    std::vector<std::size_t> pos, js;
+    std::vector<unsigned int> ids_ngram;
+    skipgrams(tokens_hashed.data(), tokens_hashed.size(), ns, ks, ngram, pos, js,
+              [&](const Text &skipgram){ ids_ngram.push_back(index.id(skipgram)); });
+
+    // Join elements of ngrams only once for each type
+    std::vector<unsigned int> ids_joined;
+    CharacterVector types_ngram = as_utf8(join_ngrams(index.ngrams, types, delim, ids_joined));
+    StringVector tokens_ngram(ids_ngram.size());
+    for (std::size_t j = 0; j < ids_ngram.size(); j++) {
+        SET_STRING_ELT(tokens_ngram, j, STRING_ELT(types_ngram, ids_joined[ids_ngram[j]] - 1));
     }
     return tokens_ngram;
 }
 
+// [[Rcpp::export]]
+List skipgram_hashed_cppl(List texts,
+                          const std::vector<std::string> &types,
+                          const std::vector<int> &ns,
+                          const std::vector<int> &ks,
+                          const std::string &delim) {
+
+    // Generate skipgrams of token IDs, giving each distinct ngram a new ID
+    NgramIndex index;
+    Text ngram, text_ngram;
+    std::vector<std::size_t> pos, js;
+    int len = texts.size();
+    List texts_ngram(len);
+    for (int h = 0; h < len; h++) {
+        SEXP text = texts[h];
+        text_ngram.clear();
+        skipgrams(INTEGER(text), LENGTH(text), ns, ks, ngram, pos, js,
+                  [&](const Text &skipgram){ text_ngram.push_back(index.id(skipgram)); });
+        texts_ngram[h] = as_integer(text_ngram);
+    }
+
+    // Join elements of ngrams only once for each type, and merge ngrams
+    // that make the same string
+    std::vector<unsigned int> ids_joined;
+    std::vector<std::string> types_ngram = join_ngrams(index.ngrams, types, delim, ids_joined);
+    if (types_ngram.size() < index.ngrams.size()) {
+        for (int h = 0; h < len; h++) {
+            IntegerVector text_ngram = texts_ngram[h];
+            for (int i = 0; i < text_ngram.size(); i++) {
+                text_ngram[i] = ids_joined[text_ngram[i]];
+            }
+        }
+    }
+    texts_ngram.attr("types") = as_utf8(types_ngram);
+    return texts_ngram;
+}
+
+// Count skipgrams in documents without making tokens of them, and return the
+// slots of a dgCMatrix as dfm_hashed_cppl() does
+// [[Rcpp::export]]
+List dfm_skipgram_hashed_cppl(List texts,
+                              const std::vector<std::string> &types,
+                              const std::vector<int> &ns,
+                              const std::vector<int> &ks,
+                              const std::string &delim) {
 
+    NgramIndex index;
+    Text ngram;
+    std::vector<std::size_t> pos, js;
+    std::vector<int> counter(1, 0);
+    std::vector<unsigned int> touched;
+    int len = texts.size();
+    std::vector<Counts> counts_docs(len);
+    for (int h = 0; h < len; h++) {
+        SEXP text = texts[h];
+        touched.clear();
+        skipgrams(INTEGER(text), LENGTH(text), ns, ks, ngram, pos, js,
+                  [&](const Text &skipgram){
+                      unsigned int id = index.id(skipgram);
+                      if (id == 0) return; // padding
+                      if (id >= counter.size()) counter.resize(id + 1, 0);
+                      if (counter[id]++ == 0) touched.push_back(id);
+                  });
+        Counts &counts = counts_docs[h];
+        counts.reserve(touched.size());
+        for (std::size_t j = 0; j < touched.size(); j++) {
+            counts.push_back(std::make_pair(touched[j], counter[touched[j]]));
+            counter[touched[j]] = 0;
+        }
+    }
+
+    // Merge counts of ngrams that make the same string
+    std::vector<unsigned int> ids_joined;
+    std::vector<std::string> types_ngram = join_ngrams(index.ngrams, types, delim, ids_joined);
+    if (types_ngram.size() < index.ngrams.size()) {
+        for (int h = 0; h < len; h++) {
+            Counts &counts = counts_docs[h];
+            for (std::size_t j = 0; j < counts.size(); j++) {
+                counts[j].first = ids_joined[counts[j].first];
+            }
+            std::sort(counts.begin(), counts.end());
+            std::size_t k = 0;
+            for (std::size_t j = 0; j < counts.size(); j++) {
+                if (k > 0 && counts[k - 1].first == counts[j].first) {
+                    counts[k - 1].second += counts[j].second;
+                } else {
+                    counts[k++] = counts[j];
+                }
+            }
+            counts.resize(k);
+        }
+    }
 
+    List slots = dfm_slots(counts_docs, types_ngram.size());
+    std::vector<int> types_used = slots["types"];
+    std::vector<std::string> types_slots(types_used.size());
+    for (std::size_t g = 0; g < types_used.size(); g++) {
+        types_slots[g] = types_ngram[types_used[g] - 1];
+    }
+    slots["types"] = as_utf8(types_slots);
+    return slots;
+}
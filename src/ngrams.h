@@ -0,0 +1,60 @@
+#ifndef QUANTEDA_NGRAMS_H
+#define QUANTEDA_NGRAMS_H
+
+#include "quanteda.h"
+#include <algorithm>
+
+// Generate skipgrams of token IDs without recursion, calling ngram_found() with
+// each of them. Positions of tokens are advanced by the elements of ks in
+// depth-first order, so skipgrams are in the same order as generated
+// recursively. The ngram and the vectors of positions and skips are buffers
+// reused across documents. Sizes and skips less than 1 are ignored rather than
+// stopped on, since this may be called from parallel threads; callers validate
+// them beforehand.
+template <typename F>
+void skipgrams(const int *tokens,
+               const std::size_t &len_tokens,
+               const std::vector<int> &ns,
+               const std::vector<int> &ks,
+               Text &ngram,
+               std::vector<std::size_t> &pos,
+               std::vector<std::size_t> &js,
+               F ngram_found){
+
+    if (std::find_if(ks.begin(), ks.end(), [](int k){ return k < 1; }) != ks.end()) return;
+    std::size_t len_ks = ks.size();
+    for (std::size_t g = 0; g < ns.size(); g++) {
+        if (ns[g] < 1) continue;
+        std::size_t n = ns[g];
+        ngram.resize(n);
+        pos.resize(n);
+        js.resize(n);
+        for (std::size_t start = 0; start < len_tokens; start++) {
+            pos[0] = start;
+            ngram[0] = tokens[start];
+            if (n == 1) {
+                ngram_found(ngram);
+                continue;
+            }
+            std::size_t d = 1;
+            js[d] = 0;
+            while (d > 0) {
+                if (js[d] < len_ks && pos[d - 1] + ks[js[d]] < len_tokens) {
+                    pos[d] = pos[d - 1] + ks[js[d]];
+                    ngram[d] = tokens[pos[d]];
+                    js[d]++;
+                    if (d == n - 1) {
+                        ngram_found(ngram);
+                    } else {
+                        d++;
+                        js[d] = 0;
+                    }
+                } else {
+                    d--; // no more skips at this depth
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "quanteda.h"
+#include "profile.h"
+
+using namespace Rcpp;
+
+#ifndef QUANTEDA_NO_PROFILE
+namespace profile {
+bool enabled = false;
+std::vector<Record> records;
+}
+#endif
+
+// Switch the recording of profiles of native calls on or off, returning
+// whether it was on; always FALSE if profiling is compiled out
+// [[Rcpp::export]]
+bool profile_enable_cpp(const bool enable){
+#ifndef QUANTEDA_NO_PROFILE
+    bool previous = profile::enabled;
+    profile::enabled = enable;
+    return previous;
+#else
+    return false;
+#endif
+}
+
+// [[Rcpp::export]]
+bool profile_compiled_cpp(){
+#ifndef QUANTEDA_NO_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Profiles recorded so far as the columns of a data.frame, with one row for
+// each counter or timer of each call
+// [[Rcpp::export]]
+List profile_records_cpp(const bool clear){
+
+    std::vector<int> calls;
+    std::vector<std::string> functions, types, names;
+    std::vector<double> values;
+#ifndef QUANTEDA_NO_PROFILE
+    for (std::size_t k = 0; k < profile::records.size(); k++) {
+        const profile::Record &record = profile::records[k];
+        for (std::size_t j = 0; j < record.counters.size(); j++) {
+            calls.push_back(k + 1);
+            functions.push_back(record.function);
+            types.push_back("counter");
+            names.push_back(record.counters[j].first);
+            values.push_back(record.counters[j].second);
+        }
+        for (std::size_t j = 0; j < record.timers.size(); j++) {
+            calls.push_back(k + 1);
+            functions.push_back(record.function);
+            types.push_back("seconds");
+            names.push_back(record.timers[j].first);
+            values.push_back(record.timers[j].second);
+        }
+    }
+    if (clear) std::vector<profile::Record>().swap(profile::records);
+#endif
+    return List::create(_["call"] = IntegerVector(calls.begin(), calls.end()),
+                        _["function"] = as_utf8(functions),
+                        _["type"] = as_utf8(types),
+                        _["name"] = as_utf8(names),
+                        _["value"] = NumericVector(values.begin(), values.end()));
+}
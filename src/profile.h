@@ -0,0 +1,88 @@
+#ifndef QUANTEDA_PROFILE_H
+#define QUANTEDA_PROFILE_H
+
+// Instrumentation of native functions: counters and timers of the stages of
+// each call are recorded when profiling is switched on from R, and can be
+// compiled out entirely by defining QUANTEDA_NO_PROFILE, e.g. in PKG_CPPFLAGS.
+// Profiling macros must only be used on the main thread, outside parallel
+// regions; counts made inside them should be reduced first.
+
+#ifndef QUANTEDA_NO_PROFILE
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace profile {
+
+typedef std::vector< std::pair<std::string, double> > Values;
+
+// Counters and the seconds spent in each stage of a call
+struct Record {
+    std::string function;
+    Values counters;
+    Values timers;
+};
+
+extern bool enabled;
+extern std::vector<Record> records;
+
+// Records a call of a native function when it goes out of scope, if profiling
+// is switched on. Stages are timed from one call of stage() to the next.
+class Call {
+    Record record;
+    bool active;
+    std::string stage_name;
+    std::chrono::steady_clock::time_point stage_start;
+
+    void end_stage() {
+        if (stage_name.empty()) return;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - stage_start;
+        record.timers.push_back(std::make_pair(stage_name, elapsed.count()));
+        stage_name.clear();
+    }
+
+public:
+    explicit Call(const char *function) : active(enabled) {
+        if (active) record.function = function;
+    }
+
+    ~Call() {
+        if (!active) return;
+        end_stage();
+        if (records.size() >= 10000) records.erase(records.begin(), records.begin() + 5000);
+        records.push_back(record);
+    }
+
+    void count(const char *name, const double value) {
+        if (active) record.counters.push_back(std::make_pair(std::string(name), value));
+    }
+
+    void stage(const char *name) {
+        if (!active) return;
+        end_stage();
+        stage_name = name;
+        stage_start = std::chrono::steady_clock::now();
+    }
+
+    bool is_active() const {
+        return active;
+    }
+};
+
+}
+
+#define PROFILE_CALL(function) profile::Call profile_call_(function)
+#define PROFILE_STAGE(name) profile_call_.stage(name)
+#define PROFILE_COUNT(name, value) do { if (profile_call_.is_active()) profile_call_.count(name, value); } while (0)
+
+#else
+
+#define PROFILE_CALL(function)
+#define PROFILE_STAGE(name) do {} while (0)
+#define PROFILE_COUNT(name, value) do {} while (0)
+
+#endif
+
+#endif
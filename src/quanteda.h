@@ -0,0 +1,129 @@
+#ifndef QUANTEDA_H
+#define QUANTEDA_H
+
+#include <Rcpp.h>
+#include <string>
+#include <vector>
+// [[Rcpp::plugins(cpp11)]]
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+
+using namespace Rcpp;
+
+// Hashed tokens are integer IDs pointing into a vector of types. IDs start
+// from 1 as in R, and 0 is reserved for padding left by removed tokens.
+typedef std::vector<unsigned int> Text;
+typedef std::vector<Text> Texts;
+typedef std::unordered_set<unsigned int> SetTypes;
+
+// Hash function for sequences of token IDs such as ngrams
+struct hash_ngram {
+    std::size_t operator()(const Text &ngram) const {
+        std::size_t seed = ngram.size();
+        for (std::size_t i = 0; i < ngram.size(); i++) {
+            seed ^= ngram[i] + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+typedef std::unordered_map<Text, unsigned int, hash_ngram> MapNgrams;
+
+// Finalizer of splitmix64, mixing all the bits of x
+inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Counts of features in a document as pairs of type ID and frequency
+typedef std::pair<unsigned int, int> Count;
+typedef std::vector<Count> Counts;
+
+// Make the slots of a dgCMatrix from counts in documents (defined in dfm.cpp)
+List dfm_slots(std::vector<Counts> &counts_docs, const int n_types, const bool drop = true);
+
+// Trie of sequences of token IDs, used to find many sequences in a single
+// pass over documents. Children of all nodes are kept in one hash table keyed
+// by the parent node and the token ID.
+class TrieSequences {
+    std::unordered_map<uint64_t, unsigned int> children;
+    std::vector<int> values; // value of the sequence ending at each node, 0 if none
+    std::size_t depth;
+
+    static uint64_t key(unsigned int node, unsigned int id) {
+        return ((uint64_t)node << 32) | id;
+    }
+
+public:
+    TrieSequences() : values(1, 0), depth(0) {}
+
+    // Values must be positive; the first value given for a sequence is kept
+    void insert(const Text &seq, int value) {
+        unsigned int node = 0;
+        for (std::size_t i = 0; i < seq.size(); i++) {
+            auto it = children.emplace(key(node, seq[i]), values.size());
+            if (it.second) values.push_back(0);
+            node = it.first->second;
+        }
+        if (values[node] == 0) values[node] = value;
+        if (seq.size() > depth) depth = seq.size();
+    }
+
+    // Length of the longest sequence starting at text[i], and its value
+    std::size_t match_longest(const int *text, std::size_t i, std::size_t len_text,
+                              int &value) const {
+        unsigned int node = 0;
+        std::size_t len_match = 0;
+        for (std::size_t j = i; j < len_text && j - i < depth; j++) {
+            auto it = children.find(key(node, text[j]));
+            if (it == children.end()) break;
+            node = it->second;
+            if (values[node] != 0) {
+                len_match = j - i + 1;
+                value = values[node];
+            }
+        }
+        return len_match;
+    }
+
+    std::size_t size() const {
+        return values.size() - 1;
+    }
+};
+
+// Copy a document of hashed tokens out of R memory
+inline Text as_text(SEXP text_) {
+    IntegerVector text(text_);
+    return Text(text.begin(), text.end());
+}
+
+// Copy a document of hashed tokens into R memory
+inline IntegerVector as_integer(const Text &text) {
+    return IntegerVector(text.begin(), text.end());
+}
+
+// Make a character vector of UTF-8 strings
+inline CharacterVector as_utf8(const std::vector<std::string> &strs) {
+    CharacterVector result(strs.size());
+    for (std::size_t i = 0; i < strs.size(); i++) {
+        SET_STRING_ELT(result, i, Rf_mkCharLenCE(strs[i].c_str(), strs[i].size(), CE_UTF8));
+    }
+    return result;
+}
+
+// Share a document between the input and the result of a function instead of
+// copying it, marking it so that R copies it before either is modified
+inline SEXP share(SEXP text) {
+#ifdef MARK_NOT_MUTABLE
+    MARK_NOT_MUTABLE(text);
+#else
+    SET_NAMED(text, 2);
+#endif
+    return text;
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef QUANTEDA_RESIDUALS_H
+#define QUANTEDA_RESIDUALS_H
+
+// Sparse counts of a dfm and products with the matrix of their chi-squared
+// residuals, shared by the scaling models that start from or decompose it
+
+#include <RcppArmadillo.h>
+#include <vector>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Counts of a dfm stored both by features (columns) and by documents (rows),
+// so that the Newton updates of either set of parameters only visit the
+// non-zero counts of their own feature or document
+struct SparseCounts {
+    int N, K;
+    std::vector<int> col_p, col_i;  // CSC: documents of each feature
+    std::vector<double> col_x;
+    std::vector<int> row_p, row_k;  // CSR: features of each document
+    std::vector<double> row_x;
+    std::vector<double> rsum, csum;
+};
+
+inline SparseCounts sparse_counts(const Rcpp::IntegerVector &slot_i,
+                                  const Rcpp::IntegerVector &slot_p,
+                                  const Rcpp::NumericVector &slot_x, const int N, const int K){
+
+    SparseCounts Y;
+    Y.N = N;
+    Y.K = K;
+    Y.col_p = Rcpp::as< std::vector<int> >(slot_p);
+    Y.col_i = Rcpp::as< std::vector<int> >(slot_i);
+    Y.col_x = Rcpp::as< std::vector<double> >(slot_x);
+    int nnz = Y.col_p[K];
+
+    Y.rsum.assign(N, 0.0);
+    Y.csum.assign(K, 0.0);
+    Y.row_p.assign(N + 1, 0);
+    for (int k = 0; k < K; k++) {
+        for (int j = Y.col_p[k]; j < Y.col_p[k + 1]; j++) {
+            Y.csum[k] += Y.col_x[j];
+            Y.rsum[Y.col_i[j]] += Y.col_x[j];
+            Y.row_p[Y.col_i[j] + 1]++;
+        }
+    }
+    for (int i = 0; i < N; i++) Y.row_p[i + 1] += Y.row_p[i];
+
+    // Transpose to CSR; features are visited in order so are sorted in rows
+    Y.row_k.resize(nnz);
+    Y.row_x.resize(nnz);
+    std::vector<int> pos(Y.row_p.begin(), Y.row_p.end() - 1);
+    for (int k = 0; k < K; k++) {
+        for (int j = Y.col_p[k]; j < Y.col_p[k + 1]; j++) {
+            int m = pos[Y.col_i[j]]++;
+            Y.row_k[m] = k;
+            Y.row_x[m] = Y.col_x[j];
+        }
+    }
+    return Y;
+}
+
+// Products with the N x K matrix of chi-squared residuals (y - e) / sqrt(e),
+// where e = rsum * csum / asum, without forming it: the matrix is the sparse
+// matrix of counts scaled by sqrt(asum / (rsum * csum)), minus the rank-one
+// matrix of sqrt(rsum / asum) and sqrt(csum). A constant smooth added to every
+// count is another rank-one term, so smoothed counts are never formed either.
+class ResidualMatrix {
+    const SparseCounts &Y;
+    double smooth;
+    int thread;
+
+public:
+    std::vector<double> rsum, csum; // smoothed margins
+    double asum;
+    std::vector<double> scale_row, scale_col;
+
+    ResidualMatrix(const SparseCounts &Y_, const int thread_, const double smooth_ = 0.0) :
+        Y(Y_), smooth(smooth_), thread(thread_) {
+        rsum = Y.rsum;
+        csum = Y.csum;
+        for (int i = 0; i < Y.N; i++) rsum[i] += smooth * Y.K;
+        for (int k = 0; k < Y.K; k++) csum[k] += smooth * Y.N;
+        asum = 0.0;
+        for (int i = 0; i < Y.N; i++) asum += rsum[i];
+        scale_row.resize(Y.N);
+        scale_col.resize(Y.K);
+        for (int i = 0; i < Y.N; i++) scale_row[i] = std::sqrt(rsum[i] / asum);
+        for (int k = 0; k < Y.K; k++) scale_col[k] = std::sqrt(csum[k]);
+    }
+
+    // C * X for X of K x l
+    arma::mat times(const arma::mat &X) const {
+        arma::mat Z(Y.N, X.n_cols);
+        arma::rowvec cx = arma::trans(arma::vec(scale_col)) * X;
+        arma::rowvec sx(X.n_cols, arma::fill::zeros);
+        if (smooth != 0.0) sx = smooth * (arma::trans(1.0 / arma::vec(scale_col)) * X);
+        #ifdef _OPENMP
+        #pragma omp parallel for num_threads(thread) schedule(dynamic, 64)
+        #endif
+        for (int i = 0; i < Y.N; i++) {
+            for (arma::uword l = 0; l < X.n_cols; l++) {
+                double z = sx(l);
+                for (int j = Y.row_p[i]; j < Y.row_p[i + 1]; j++) {
+                    int k = Y.row_k[j];
+                    z += Y.row_x[j] / scale_col[k] * X(k, l);
+                }
+                Z(i, l) = z / scale_row[i] - scale_row[i] * cx(l);
+            }
+        }
+        return Z;
+    }
+
+    // C' * X for X of N x l
+    arma::mat trans_times(const arma::mat &X) const {
+        arma::mat Z(Y.K, X.n_cols);
+        arma::rowvec rx = arma::trans(arma::vec(scale_row)) * X;
+        arma::rowvec sx(X.n_cols, arma::fill::zeros);
+        if (smooth != 0.0) sx = smooth * (arma::trans(1.0 / arma::vec(scale_row)) * X);
+        #ifdef _OPENMP
+        #pragma omp parallel for num_threads(thread) schedule(dynamic, 64)
+        #endif
+        for (int k = 0; k < Y.K; k++) {
+            for (arma::uword l = 0; l < X.n_cols; l++) {
+                double z = sx(l);
+                for (int j = Y.col_p[k]; j < Y.col_p[k + 1]; j++) {
+                    int i = Y.col_i[j];
+                    z += Y.col_x[j] / scale_row[i] * X(i, l);
+                }
+                Z(k, l) = z / scale_col[k] - scale_col[k] * rx(l);
+            }
+        }
+        return Z;
+    }
+
+    // Sums of the squared residuals of each row and of each column, from the
+    // non-zero counts and the margins
+    void squares(std::vector<double> &row_sq, std::vector<double> &col_sq) const {
+        double s2 = smooth * smooth;
+        double inv_col = 0.0, inv_row = 0.0;
+        for (int k = 0; k < Y.K; k++) inv_col += 1.0 / csum[k];
+        for (int i = 0; i < Y.N; i++) inv_row += 1.0 / (scale_row[i] * scale_row[i]);
+        row_sq.assign(Y.N, s2 * inv_col);
+        col_sq.assign(Y.K, s2 * inv_row);
+        for (int k = 0; k < Y.K; k++) {
+            for (int j = Y.col_p[k]; j < Y.col_p[k + 1]; j++) {
+                int i = Y.col_i[j];
+                double v = (Y.col_x[j] + smooth) * (Y.col_x[j] + smooth) - s2;
+                row_sq[i] += v / csum[k];
+                col_sq[k] += v / (scale_row[i] * scale_row[i]);
+            }
+        }
+        for (int i = 0; i < Y.N; i++) row_sq[i] = row_sq[i] / (scale_row[i] * scale_row[i]) - rsum[i];
+        for (int k = 0; k < Y.K; k++) col_sq[k] = col_sq[k] / csum[k] - csum[k];
+    }
+};
+
+#endif
@@ -1,9 +1,12 @@
 #include <Rcpp.h>
-#include <set>
-#include <map>
 #include <vector>
+#include <algorithm>
 // [[Rcpp::plugins(cpp11)]]
-#include <unordered_set>
+#include "quanteda.h"
+#include "profile.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace Rcpp;
 
@@ -13,15 +16,15 @@ void print_vector(const std::string label,
   
   if(tokens.size() == 0) return;
   std::string token_joined = tokens[0];
-  for(int i = 1; i < tokens.size(); ++i){
+  for(std::size_t i = 1; i < tokens.size(); ++i){
     token_joined = token_joined + " " + tokens[i];
   }
   Rcout << label << ": " << token_joined << "\n";
 }
 
-// [[Rcpp::export]]
-int match_bit(const std::vector<std::string> &tokens1, 
-              const std::vector<std::string> &tokens2){
+template <typename T>
+int match_bit_vector(const std::vector<T> &tokens1, 
+                     const std::vector<T> &tokens2){
   
   int len1 = tokens1.size();
   int len2 = tokens2.size();
@@ -34,7 +37,13 @@ int match_bit(const std::vector<std::string> &tokens1,
   return bit;
 }
 
-double sigma(std::vector<int> &counts, 
+// [[Rcpp::export]]
+int match_bit(const std::vector<std::string> &tokens1, 
+              const std::vector<std::string> &tokens2){
+  return match_bit_vector(tokens1, tokens2);
+}
+
+double sigma(const std::vector<double> &counts, 
              const int &n, 
              const double &smooth){
   
@@ -46,7 +55,7 @@ double sigma(std::vector<int> &counts,
   return std::sqrt(s);
 }
 
-double lambda(std::vector<int> &counts, 
+double lambda(const std::vector<double> &counts, 
               const int &n, 
               const double &smooth){
   
@@ -58,88 +67,219 @@ double lambda(std::vector<int> &counts,
   return l;
 }
 
-// [[Rcpp::export]]
-Rcpp::List find_sequence_cppl(List texts,
-                              const std::vector<std::string> &types,
-                              const int &count_min,
-                              const double &smooth,
-                              const bool &nested){
+// Collect sequences of the given types in a document
+void count_sequences(const int *text,
+                     const std::size_t &len_text,
+                     const std::vector<bool> &is_type,
+                     const bool &nested,
+                     MapNgrams &counts_seq){
+  
+  Text tokens_seq;
+  for (std::size_t i = 1; i <= len_text; i++){ // scan texts ignoring first words in texts
+    for (std::size_t j = i; j <= len_text; j++){ // collect nested sequence starting from i
+      // the end of text is treated as padding to include last words
+      bool is_in = j < len_text && is_type[text[j]];
+      if(is_in){
+        tokens_seq.push_back(text[j]);
+      }else{
+        if(tokens_seq.size() > 1){
+          counts_seq[tokens_seq]++;
+        }
+        tokens_seq.clear();
+        if(!nested) i = j; // jump if nested is false
+        break;
+      }
+    }
+  }
+}
+
+// Sequences that have a token at a position, with their lengths sorted
+struct Posting {
+  std::vector<unsigned int> seqs;
+  std::vector<std::size_t> lens;
+};
+
+// Count how many of the other sequences match a sequence at each number of
+// bits as match_bit() does. Instead of comparing all pairs of sequences, only
+// the sequences that share a token at the same position are visited through
+// an inverted index; all the others match at zero positions and are counted
+// from the distribution of lengths. The largest posting of each sequence, that
+// of a frequent token, is not visited either: its sequences that share no
+// other token match at one position and are counted from its own lengths, so
+// that a frequent token does not make the pairs quadratic in its frequency.
+void estimate_sequences(const Texts &seqs,
+                        const std::vector<int> &counts,
+                        const double &smooth,
+                        std::vector<double> &lambdas,
+                        std::vector<double> &sigmas,
+                        const int thread){
   
-  //Rcpp::List texts(x);
-  std::map<std::vector<std::string>, int> counts_seq; // unorderd_map cannot take vector as key
-  std::unordered_set<std::string> set_types (types.begin(), types.end());
+  std::size_t len = seqs.size();
+  std::size_t len_max = 0;
+  std::unordered_map<uint64_t, Posting> postings;
+  for (std::size_t k = 0; k < len; k++){
+    for (std::size_t i = 0; i < seqs[k].size(); i++){
+      Posting &posting = postings[((uint64_t)i << 32) | seqs[k][i]];
+      posting.seqs.push_back(k);
+      posting.lens.push_back(seqs[k].size());
+    }
+    len_max = std::max(len_max, seqs[k].size());
+  }
+  for (auto it = postings.begin(); it != postings.end(); ++it){
+    std::sort(it->second.lens.begin(), it->second.lens.end());
+  }
   
-  // Find all sequences of specified types
-  for (int h = 0; h < texts.size(); h++){
-    
-    //Rcout << "Text " << h << "\n";
-    std::vector<std::string> text = texts[h];
-    std::vector<std::string> tokens_seq;
-    text.push_back(""); // add empty token to include last words
-    
-    int len_text = text.size();
-    //print_vector("Text", text);
-    for (int i = 1; i < len_text; i++){ // scan texts ignoring first words in texts
-      for (int j = i; j < len_text; j++){ // collect nested sequence starting from i
-        //Rcout << i << " " << j << "\n";
-        Rcpp::String token = text[j];
-        bool is_in;
-        if(token == ""){
-          is_in = false;
-        }else{
-          is_in = set_types.find(token) != set_types.end();
+  // Number of sequences that are not longer than n
+  std::vector<int> counts_len(len_max + 1, 0);
+  for (std::size_t k = 0; k < len; k++) counts_len[seqs[k].size()]++;
+  for (std::size_t n = 1; n <= len_max; n++) counts_len[n] += counts_len[n - 1];
+  
+  #ifdef _OPENMP
+  #pragma omp parallel num_threads(thread)
+  #endif
+  {
+    std::vector<int> matches(len, 0);
+    std::vector<unsigned int> touched;
+    std::vector<const Posting*> postings_seq;
+    #ifdef _OPENMP
+    #pragma omp for schedule(dynamic, 64)
+    #endif
+    for (std::size_t k1 = 0; k1 < len; k1++){
+      const Text &seq = seqs[k1];
+      int n = seq.size();
+      postings_seq.resize(n);
+      int i_max = 0;
+      for (int i = 0; i < n; i++){
+        postings_seq[i] = &postings.find(((uint64_t)i << 32) | seq[i])->second;
+        if(postings_seq[i]->seqs.size() > postings_seq[i_max]->seqs.size()) i_max = i;
+      }
+      touched.clear();
+      for (int i = 0; i < n; i++){
+        if(i == i_max) continue;
+        const std::vector<unsigned int> &posting = postings_seq[i]->seqs;
+        for (std::size_t m = 0; m < posting.size(); m++){
+          unsigned int k2 = posting[m];
+          if(k2 == k1) continue; // do not compare with itself
+          if(matches[k2]++ == 0) touched.push_back(k2);
         }
-        if(is_in){
-          //Rcout << "Match: " << token.get_cstring() << "\n";
-          tokens_seq.push_back(token);
-        }else{
-          //Rcout << "Not match: " <<  token.get_cstring() << "\n";
-          if(tokens_seq.size() > 1){
-            counts_seq[tokens_seq]++;
-            //print_vector("Sequence", tokens_seq);
+      }
+      
+      // Sequences in the largest posting but in no other
+      const Posting &posting_max = *postings_seq[i_max];
+      double n_max_shorter = std::upper_bound(posting_max.lens.begin(), posting_max.lens.end(), (std::size_t)n) -
+                             posting_max.lens.begin() - 1; // other than itself
+      double n_max_longer = posting_max.lens.size() - 1 - n_max_shorter;
+      
+      std::vector<double> counts_bit(n + 1, 0);
+      double n_shorter = counts_len[n] - 1; // all others have a trailing space
+      double n_longer = len - counts_len[n];
+      for (std::size_t m = 0; m < touched.size(); m++){
+        unsigned int k2 = touched[m];
+        bool is_shorter = n >= (int)seqs[k2].size();
+        if((int)seqs[k2].size() > i_max && seqs[k2][i_max] == seq[i_max]){
+          matches[k2]++;
+          if(is_shorter){
+            n_max_shorter--;
+          }else{
+            n_max_longer--;
           }
-          //print_vector("Reset", tokens_seq);
-          tokens_seq.clear();
-          if(!nested) i = j; // jump if nested is false
-          break;
         }
+        counts_bit[matches[k2] + is_shorter]++;
+        if(is_shorter){
+          n_shorter--;
+        }else{
+          n_longer--;
+        }
+        matches[k2] = 0;
       }
+      counts_bit[2] += n_max_shorter;
+      counts_bit[1] += n_max_longer;
+      counts_bit[1] += n_shorter - n_max_shorter;
+      counts_bit[0] += n_longer - n_max_longer;
+      for (int b = 0; b <= n; b++) counts_bit[b] *= counts[k1];
+      sigmas[k1] = sigma(counts_bit, n, smooth);
+      lambdas[k1] = lambda(counts_bit, n, smooth);
     }
   }
+}
+
+// [[Rcpp::export]]
+Rcpp::List find_sequence_hashed_cppl(List texts,
+                                     const std::vector<int> &types,
+                                     const int &count_min,
+                                     const double &smooth,
+                                     const bool &nested,
+                                     const int thread){
   
-  // Find significance of sequences
+  PROFILE_CALL("find_sequence_hashed_cppl");
+  PROFILE_STAGE("count");
+  int len = texts.size();
+  std::vector<const int*> ptrs(len);
+  std::vector<std::size_t> lens(len);
+  int id_max = 0;
+  for (int h = 0; h < len; h++){
+    SEXP text = texts[h];
+    ptrs[h] = INTEGER(text);
+    lens[h] = LENGTH(text);
+    for (std::size_t i = 0; i < lens[h]; i++) id_max = std::max(id_max, ptrs[h][i]);
+  }
+  std::vector<bool> is_type(id_max + 1, false); // padding is never a type
+  for (std::size_t g = 0; g < types.size(); g++){
+    if(types[g] > 0 && types[g] <= id_max) is_type[types[g]] = true;
+  }
   
-  //vector<double> ms;
-  std::vector<double> sigmas;
-  std::vector<double> lambdas;
-  Rcpp::List sequences;
-  for(auto it1 = counts_seq.begin(); it1 != counts_seq.end(); ++it1 ){
-    if(it1->first.size() < 2) continue; // ignore single words
-    if(it1->second < count_min) continue;
-    // Initialize
-    int n = it1->first.size();
-    std::vector<int> counts_bit(n + 1);
-    for(auto it2 = counts_seq.begin(); it2 != counts_seq.end(); ++it2 ){
-      if(it2->second <  count_min) continue;
-      if(it1->first == it2->first) continue; // do not compare with itself
-      int bit = match_bit(it1->first, it2->first);
-      counts_bit[bit] += it1->second;
-      //Rcout << join(it1->first, "-") << " vs " << join(it2->first, "-") << ": "
-      //      << bit << " x " << it1->second << "\n";
+  // Find all sequences of specified types, counting documents in parallel
+  MapNgrams counts_seq;
+  #ifdef _OPENMP
+  #pragma omp parallel num_threads(thread)
+  #endif
+  {
+    MapNgrams counts_seq_thread;
+    #ifdef _OPENMP
+    #pragma omp for schedule(dynamic, 16) nowait
+    #endif
+    for (int h = 0; h < len; h++){
+      count_sequences(ptrs[h], lens[h], is_type, nested, counts_seq_thread);
     }
-    //double s = sigma(counts_bit, n, 0.5);
-    //double l = lambda(counts_bit, n, 0.5);
-    //double m = l - (3.29 * s);
-    //print_vector("Token", it1->first);
-    //Rcout << m << "\n";
-    //Rcout << join(it1->first, "-") << ": " << m << "\n";
-    //tokens_seq_temp.push_back(join(it1->first, "-"));
-    sequences.push_back(it1->first);
-    sigmas.push_back(sigma(counts_bit, n, smooth));
-    lambdas.push_back(lambda(counts_bit, n, smooth));
+    #ifdef _OPENMP
+    #pragma omp critical
+    #endif
+    for (auto it = counts_seq_thread.begin(); it != counts_seq_thread.end(); ++it){
+      counts_seq[it->first] += it->second;
+    }
+  }
+  
+  PROFILE_COUNT("documents", len);
+  PROFILE_COUNT("sequences_counted", counts_seq.size());
+  PROFILE_COUNT("sequences_load_factor", counts_seq.load_factor());
+  
+  // Sequences are sorted to make the results reproducible
+  PROFILE_STAGE("sort");
+  Texts sequences;
+  for (auto it = counts_seq.begin(); it != counts_seq.end(); ++it){
+    if((int)it->second >= count_min) sequences.push_back(it->first);
+  }
+  std::sort(sequences.begin(), sequences.end());
+  std::vector<int> counts(sequences.size());
+  for (std::size_t k = 0; k < sequences.size(); k++){
+    counts[k] = counts_seq[sequences[k]];
   }
-  return Rcpp::List::create(Rcpp::Named("sequence") = sequences,
+  
+  PROFILE_COUNT("sequences_kept", sequences.size());
+  
+  // Find significance of sequences
+  PROFILE_STAGE("estimate");
+  std::vector<double> sigmas(sequences.size());
+  std::vector<double> lambdas(sequences.size());
+  estimate_sequences(sequences, counts, smooth, lambdas, sigmas, thread);
+  
+  PROFILE_STAGE("write");
+  Rcpp::List sequences_hashed(sequences.size());
+  for (std::size_t i = 0; i < sequences.size(); i++){
+    sequences_hashed[i] = as_integer(sequences[i]);
+  }
+  return Rcpp::List::create(Rcpp::Named("sequence") = sequences_hashed,
                             Rcpp::Named("lambda") = lambdas,
                             Rcpp::Named("sigma") = sigmas
                             );
-}
\ No newline at end of file
+}
@@ -0,0 +1,182 @@
+#include "quanteda.h"
+#include <algorithm>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Compressed sparse vectors of items, or of dimensions
+struct Compressed {
+    std::vector<int> p, i;
+    std::vector<double> x;
+};
+
+Compressed transpose(const Compressed &m, const int n_rows){
+    Compressed t;
+    int n_cols = m.p.size() - 1;
+    t.p.assign(n_rows + 1, 0);
+    t.i.resize(m.i.size());
+    t.x.resize(m.x.size());
+    for (std::size_t j = 0; j < m.i.size(); j++) t.p[m.i[j] + 1]++;
+    for (int r = 0; r < n_rows; r++) t.p[r + 1] += t.p[r];
+    std::vector<int> pos(t.p.begin(), t.p.end() - 1);
+    for (int c = 0; c < n_cols; c++) {
+        for (int j = m.p[c]; j < m.p[c + 1]; j++) {
+            int k = pos[m.i[j]]++;
+            t.i[k] = c;
+            t.x[k] = m.x[j];
+        }
+    }
+    return t;
+}
+
+enum Method { COSINE, CORRELATION, JACCARD, EJACCARD, DICE, EDICE, SIMPLE_MATCHING };
+
+// Similarity of items a and b from their inner product, the number of
+// dimensions in which both are non-zero, and the sums, sums of squares and
+// numbers of non-zero values of each
+inline double simil(const Method method, const double dot, const double both, const double n,
+                    const double s1a, const double s2a, const double ca,
+                    const double s1b, const double s2b, const double cb){
+    switch (method) {
+    case COSINE:
+        return dot / std::sqrt(s2a * s2b);
+    case CORRELATION:
+        return (dot - s1a * s1b / n) / std::sqrt((s2a - s1a * s1a / n) * (s2b - s1b * s1b / n));
+    case JACCARD:
+        return both / (ca + cb - both);
+    case EJACCARD:
+        return dot / (s2a + s2b - dot);
+    case DICE:
+        return 2 * both / (ca + cb);
+    case EDICE:
+        return 2 * dot / (s2a + s2b);
+    case SIMPLE_MATCHING:
+        return (n - ca - cb + 2 * both) / n;
+    }
+    return NA_REAL;
+}
+
+typedef std::pair<double, int> Simil;
+
+// Order by descending similarity, then by position, with NaN last, as
+// sort(decreasing = TRUE, na.last = TRUE) does
+inline bool higher(const Simil &a, const Simil &b){
+    if (std::isnan(a.first)) return !std::isnan(b.first) ? false : a.second < b.second;
+    if (std::isnan(b.first)) return true;
+    if (a.first != b.first) return a.first > b.first;
+    return a.second < b.second;
+}
+
+// Compute the similarity of the target items to all other items of a
+// dgCMatrix, keeping only the n most similar to each target in a bounded heap,
+// or the first n in order if not sorted. Items are the rows if margin is 1, or
+// the columns if margin is 2. Inner products are accumulated from the
+// non-zero values shared with each target, so the matrix of similarities is
+// never made.
+// [[Rcpp::export]]
+List similarity_cppl(const IntegerVector &slot_i, const IntegerVector &slot_p,
+                     const NumericVector &slot_x, const int n_rows, const int n_cols,
+                     const int margin, const IntegerVector &targets, const int n,
+                     const std::string &method, const bool sorted, const int thread){
+
+    Method m;
+    if (method == "cosine") m = COSINE;
+    else if (method == "correlation") m = CORRELATION;
+    else if (method == "jaccard") m = JACCARD;
+    else if (method == "ejaccard") m = EJACCARD;
+    else if (method == "dice") m = DICE;
+    else if (method == "edice") m = EDICE;
+    else if (method == "simple matching") m = SIMPLE_MATCHING;
+    else stop("Invalid method");
+
+    Compressed cols;
+    cols.p = as< std::vector<int> >(slot_p);
+    cols.i = as< std::vector<int> >(slot_i);
+    cols.x = as< std::vector<double> >(slot_x);
+    Compressed rows = transpose(cols, n_rows);
+
+    // Non-zero values of each item, and items of each dimension
+    const Compressed &items = (margin == 1) ? rows : cols;
+    const Compressed &dims = (margin == 1) ? cols : rows;
+    int n_items = (margin == 1) ? n_rows : n_cols;
+    double n_dims = (margin == 1) ? n_cols : n_rows;
+
+    std::vector<double> s1(n_items, 0.0), s2(n_items, 0.0), cnt(n_items, 0.0);
+    for (int a = 0; a < n_items; a++) {
+        for (int j = items.p[a]; j < items.p[a + 1]; j++) {
+            s1[a] += items.x[j];
+            s2[a] += items.x[j] * items.x[j];
+            if (items.x[j] != 0) cnt[a]++;
+        }
+    }
+
+    int n_targets = targets.size();
+    std::vector<int> ids(targets.begin(), targets.end());
+    std::vector< std::vector<Simil> > results(n_targets);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<double> dot(n_items, 0.0), both(n_items, 0.0);
+        std::vector<int> touched;
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 1)
+        #endif
+        for (int h = 0; h < n_targets; h++) {
+            int a = ids[h];
+            touched.clear();
+            for (int j = items.p[a]; j < items.p[a + 1]; j++) {
+                int d = items.i[j];
+                double xa = items.x[j];
+                for (int l = dims.p[d]; l < dims.p[d + 1]; l++) {
+                    int b = dims.i[l];
+                    if (dot[b] == 0 && both[b] == 0) touched.push_back(b);
+                    dot[b] += xa * dims.x[l];
+                    if (xa != 0 && dims.x[l] != 0) both[b]++;
+                }
+            }
+
+            std::vector<Simil> &result = results[h];
+            result.reserve(n);
+            for (int b = 0; b < n_items; b++) {
+                if (b == a) continue;
+                Simil s(simil(m, dot[b], both[b], n_dims, s1[a], s2[a], cnt[a], s1[b], s2[b], cnt[b]), b);
+                if (!sorted) {
+                    if ((int)result.size() == n) break;
+                    result.push_back(s);
+                } else if ((int)result.size() < n) {
+                    result.push_back(s);
+                    std::push_heap(result.begin(), result.end(), higher);
+                } else if (n > 0 && higher(s, result.front())) {
+                    // the least similar item is at the top of the heap
+                    std::pop_heap(result.begin(), result.end(), higher);
+                    result.back() = s;
+                    std::push_heap(result.begin(), result.end(), higher);
+                }
+            }
+            if (sorted) std::sort_heap(result.begin(), result.end(), higher);
+            for (std::size_t k = 0; k < touched.size(); k++) {
+                dot[touched[k]] = 0;
+                both[touched[k]] = 0;
+            }
+        }
+    }
+
+    List index(n_targets), value(n_targets);
+    for (int h = 0; h < n_targets; h++) {
+        std::vector<Simil> &result = results[h];
+        IntegerVector index_target(result.size());
+        NumericVector value_target(result.size());
+        for (std::size_t k = 0; k < result.size(); k++) {
+            index_target[k] = result[k].second + 1;
+            value_target[k] = result[k].first;
+        }
+        index[h] = index_target;
+        value[h] = value_target;
+        std::vector<Simil>().swap(result);
+    }
+    return List::create(_["index"] = index, _["value"] = value);
+}
@@ -0,0 +1,312 @@
+#include "quanteda.h"
+#include "unicode.h"
+#include "profile.h"
+#include <algorithm>
+#include <numeric>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+using namespace unicode;
+
+struct TokenizeOptions {
+    bool split_whitespace; // fasterword splits on all white space, fastestword on " "
+    bool remove_numbers, remove_punct, remove_symbols, remove_twitter, remove_hyphens, remove_url;
+};
+
+// Buffers of a thread, reused across documents
+struct TokenizeBuffers {
+    std::vector<uint32_t> chars;
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> kept;
+    std::vector<CharClass> classes;
+    std::vector<char> actions;
+    std::string token;
+};
+
+enum Action { APPEND, DROP, SPLIT };
+
+// Decode UTF-8 into characters and the offsets of their first bytes. An
+// invalid byte is taken as a character of its own.
+void decode_utf8(const char *str, const std::size_t len,
+                 std::vector<uint32_t> &chars, std::vector<std::size_t> &offsets){
+    chars.clear();
+    offsets.clear();
+    std::size_t i = 0;
+    while (i < len) {
+        unsigned char b = str[i];
+        std::size_t n = 1;
+        uint32_t c = b;
+        if (b >= 0xF0 && b < 0xF8) { n = 4; c = b & 0x07; }
+        else if (b >= 0xE0) { n = 3; c = b & 0x0F; }
+        else if (b >= 0xC0) { n = 2; c = b & 0x1F; }
+        else if (b >= 0x80) { n = 0; }
+        bool valid = n > 0 && i + n <= len;
+        for (std::size_t j = 1; valid && j < n; j++) {
+            unsigned char bj = str[i + j];
+            if ((bj & 0xC0) != 0x80) valid = false;
+            c = (c << 6) | (bj & 0x3F);
+        }
+        offsets.push_back(i);
+        if (valid) {
+            chars.push_back(c);
+            i += n;
+        } else {
+            chars.push_back(0xFFFD);
+            i += 1;
+        }
+    }
+    offsets.push_back(len);
+}
+
+inline bool in_set(const uint32_t c, const char *set){
+    if (c >= 128 || c == 0) return false;
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return true;
+    for (const char *s = set; *s; s++) {
+        if ((uint32_t)*s == c) return true;
+    }
+    return false;
+}
+
+// Length of the URL starting at i, or 0, matching the pattern used to remove
+// URLs from texts by tokenize():
+// https?:\/\/(www\.)?[-a-zA-Z0-9@:%._\+~#=]{2,256}\.[a-z]{2,4}\b([-a-zA-Z0-9@:%_\+.~#?&//=]*)
+std::size_t match_url(const std::vector<uint32_t> &chars, const std::size_t i){
+
+    std::size_t n = chars.size();
+    const char *scheme = "http";
+    std::size_t p = i;
+    for (const char *s = scheme; *s; s++, p++) {
+        if (p >= n || chars[p] != (uint32_t)*s) return 0;
+    }
+    if (p < n && chars[p] == 's') p++;
+    if (p + 3 > n || chars[p] != ':' || chars[p + 1] != '/' || chars[p + 2] != '/') return 0;
+    p += 3;
+
+    std::size_t starts[2] = {p + 4, p};
+    bool www = p + 4 <= n && chars[p] == 'w' && chars[p + 1] == 'w' && chars[p + 2] == 'w' && chars[p + 3] == '.';
+    for (int t = www ? 0 : 1; t < 2; t++) {
+        std::size_t d = starts[t];
+        std::size_t len_domain = 0;
+        while (d + len_domain < n && len_domain < 256 && in_set(chars[d + len_domain], "-@:%._+~#="))
+            len_domain++;
+        for (std::size_t l = len_domain; l >= 2; l--) {
+            std::size_t q = d + l;
+            if (q >= n || chars[q] != '.') continue;
+            std::size_t len_tld = 0;
+            while (q + 1 + len_tld < n && len_tld < 4 && chars[q + 1 + len_tld] >= 'a' && chars[q + 1 + len_tld] <= 'z')
+                len_tld++;
+            for (std::size_t m = len_tld; m >= 2; m--) {
+                std::size_t r = q + 1 + m;
+                if (r < n && is_word(char_class(chars[r]))) continue; // \b
+                while (r < n && in_set(chars[r], "-@:%_+.~#?&/=")) r++;
+                return r - i;
+            }
+        }
+    }
+    return 0;
+}
+
+// Whether a character joins a number to a word, as in "4u" or "covid-19"; an
+// intra-word hyphen joins if it is kept while other punctuation is removed
+inline bool is_attached(const CharClass type, const char action, const TokenizeOptions &opts){
+    if (action == SPLIT) return false;
+    return is_word(type) || (type == DASH && action == APPEND && opts.remove_punct);
+}
+
+// Tokenize a text in a single scan of its characters, appending the tokens.
+// Removed characters are dropped without splitting tokens. Intra-word hyphens
+// are kept as part of words, unless removed, in which case they split them.
+void tokenize_text(const char *str, const std::size_t len, const TokenizeOptions &opts,
+                   TokenizeBuffers &buf, std::vector<std::string> &tokens){
+
+    decode_utf8(str, len, buf.chars, buf.offsets);
+    std::size_t n = buf.chars.size();
+
+    // Characters left after removing URLs
+    buf.kept.clear();
+    buf.classes.clear();
+    for (std::size_t i = 0; i < n; i++) {
+        if (opts.remove_url && buf.chars[i] == 'h') {
+            std::size_t len_url = match_url(buf.chars, i);
+            if (len_url > 0) {
+                i += len_url - 1;
+                continue;
+            }
+        }
+        buf.kept.push_back(i);
+        buf.classes.push_back(char_class(buf.chars[i]));
+    }
+
+    std::size_t m = buf.kept.size();
+    std::vector<CharClass> &classes = buf.classes;
+    std::vector<char> &actions = buf.actions;
+    actions.assign(m, APPEND);
+    for (std::size_t k = 0; k < m; k++) {
+        uint32_t c = buf.chars[buf.kept[k]];
+        switch (classes[k]) {
+        case SPACE:
+            if (opts.split_whitespace || c == ' ') actions[k] = SPLIT;
+            break;
+        case DASH:
+            if (k > 0 && k + 1 < m && is_word(classes[k - 1]) && is_word(classes[k + 1])) {
+                if (opts.remove_hyphens) actions[k] = SPLIT;
+                break; // intra-word hyphen
+            }
+            if (opts.remove_punct) actions[k] = DROP;
+            break;
+        case CONNECTOR:
+        case PUNCT:
+            if (opts.remove_punct && c != '_' && (opts.remove_twitter || (c != '#' && c != '@')))
+                actions[k] = DROP;
+            break;
+        case SYMBOL:
+            if (opts.remove_symbols) actions[k] = DROP;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Numbers are runs of digits not attached to other word characters; kept
+    // intra-word hyphens are attached
+    if (opts.remove_numbers) {
+        std::size_t k = 0;
+        while (k < m) {
+            if (classes[k] != DIGIT) {
+                k++;
+                continue;
+            }
+            std::size_t e = k;
+            while (e < m && classes[e] == DIGIT) e++;
+            bool attached = (k > 0 && is_attached(classes[k - 1], actions[k - 1], opts)) ||
+                            (e < m && is_attached(classes[e], actions[e], opts));
+            if (!attached) {
+                for (std::size_t j = k; j < e; j++) actions[j] = DROP;
+            }
+            k = e;
+        }
+    }
+
+    std::string &token = buf.token;
+    token.clear();
+    for (std::size_t k = 0; k < m; k++) {
+        if (actions[k] == SPLIT) {
+            if (!token.empty()) tokens.push_back(token);
+            token.clear();
+        } else if (actions[k] == APPEND) {
+            std::size_t i = buf.kept[k];
+            token.append(str + buf.offsets[i], buf.offsets[i + 1] - buf.offsets[i]);
+        }
+    }
+    if (!token.empty()) tokens.push_back(token);
+}
+
+// Tokenize texts by white space natively, returning hashed tokens. Each
+// document is tokenized and its types indexed in parallel; the types of
+// documents are then given global IDs in order of first appearance.
+// [[Rcpp::export]]
+List tokenize_fast_hashed_cppl(const CharacterVector &texts,
+                               const bool split_whitespace,
+                               const bool remove_numbers,
+                               const bool remove_punct,
+                               const bool remove_symbols,
+                               const bool remove_twitter,
+                               const bool remove_hyphens,
+                               const bool remove_url,
+                               const int thread){
+
+    TokenizeOptions opts = {split_whitespace, remove_numbers, remove_punct, remove_symbols,
+                            remove_twitter, remove_hyphens, remove_url};
+
+    PROFILE_CALL("tokenize_fast_hashed_cppl");
+    int len = texts.size();
+    std::vector<const char*> ptrs(len);
+    std::vector<std::size_t> lens(len);
+    std::vector<char> nas(len, false);
+    for (int h = 0; h < len; h++) {
+        SEXP text = STRING_ELT(texts, h);
+        if (text == NA_STRING) {
+            nas[h] = true;
+            continue;
+        }
+        ptrs[h] = Rf_translateCharUTF8(text);
+        lens[h] = strlen(ptrs[h]);
+    }
+
+    // Tokens of each document as IDs of its own types
+    PROFILE_STAGE("tokenize");
+    std::vector< std::vector<std::string> > types_docs(len);
+    Texts texts_local(len);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        TokenizeBuffers buf;
+        std::vector<std::string> tokens;
+        std::unordered_map<std::string, unsigned int> map_local;
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < len; h++) {
+            if (nas[h]) continue;
+            tokens.clear();
+            tokenize_text(ptrs[h], lens[h], opts, buf, tokens);
+            map_local.clear();
+            Text &text = texts_local[h];
+            text.reserve(tokens.size());
+            for (std::size_t i = 0; i < tokens.size(); i++) {
+                auto it = map_local.emplace(tokens[i], types_docs[h].size());
+                if (it.second) types_docs[h].push_back(tokens[i]);
+                text.push_back(it.first->second);
+            }
+        }
+    }
+
+    // Global IDs of the types of each document, in order of documents
+    PROFILE_STAGE("types");
+    std::unordered_map<std::string, unsigned int> map_types;
+    std::vector<std::string> types;
+    std::vector<Text> ids_docs(len);
+    for (int h = 0; h < len; h++) {
+        ids_docs[h].resize(types_docs[h].size());
+        for (std::size_t j = 0; j < types_docs[h].size(); j++) {
+            auto it = map_types.emplace(types_docs[h][j], types.size() + 1);
+            if (it.second) types.push_back(types_docs[h][j]);
+            ids_docs[h][j] = it.first->second;
+        }
+        std::vector<std::string>().swap(types_docs[h]);
+    }
+
+    PROFILE_COUNT("documents", len);
+    PROFILE_COUNT("documents_na", std::count(nas.begin(), nas.end(), true));
+    PROFILE_COUNT("bytes", std::accumulate(lens.begin(), lens.end(), 0.0));
+    PROFILE_COUNT("types", types.size());
+    PROFILE_COUNT("types_load_factor", map_types.load_factor());
+
+    PROFILE_STAGE("recode");
+    double n_tokens = 0;
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 16) reduction(+:n_tokens)
+    #endif
+    for (int h = 0; h < len; h++) {
+        Text &text = texts_local[h];
+        for (std::size_t i = 0; i < text.size(); i++) text[i] = ids_docs[h][text[i]];
+        n_tokens += text.size();
+    }
+    PROFILE_COUNT("tokens", n_tokens);
+
+    PROFILE_STAGE("write");
+    List texts_hashed(len);
+    for (int h = 0; h < len; h++) {
+        if (nas[h]) {
+            texts_hashed[h] = IntegerVector(0); // NA is an empty document
+        } else {
+            texts_hashed[h] = as_integer(texts_local[h]);
+            Text().swap(texts_local[h]);
+        }
+    }
+    texts_hashed.attr("types") = as_utf8(types);
+    return texts_hashed;
+}
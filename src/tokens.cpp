@@ -0,0 +1,108 @@
+#include "quanteda.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// [[Rcpp::export]]
+List hash_tokens_cppl(List texts,
+                      const CharacterVector &types){
+
+    // Types given are kept with their IDs, so that new documents can be hashed
+    // against an existing vocabulary
+    std::unordered_map<std::string, unsigned int> map_types;
+    std::vector<std::string> types_all;
+    map_types.reserve(types.size());
+    types_all.reserve(types.size());
+    for (int g = 0; g < types.size(); g++) {
+        std::string type = Rf_translateCharUTF8(STRING_ELT(types, g));
+        if (map_types.emplace(type, types_all.size() + 1).second) {
+            types_all.push_back(type);
+        }
+    }
+
+    int len = texts.size();
+    List texts_hashed(len);
+    for (int h = 0; h < len; h++) {
+        if (TYPEOF(texts[h]) == NILSXP) {
+            texts_hashed[h] = IntegerVector(0);
+            continue;
+        }
+        if (TYPEOF(texts[h]) != STRSXP) {
+            stop("Each element of the list must be a character vector");
+        }
+        CharacterVector text = texts[h];
+        int len_text = text.size();
+        IntegerVector text_hashed(len_text);
+        for (int i = 0; i < len_text; i++) {
+            SEXP token = STRING_ELT(text, i);
+            if (token == NA_STRING || LENGTH(token) == 0) {
+                text_hashed[i] = 0; // padding
+                continue;
+            }
+            // Strings are compared in UTF-8 regardless of their declared encoding
+            auto it = map_types.emplace(Rf_translateCharUTF8(token), types_all.size() + 1);
+            if (it.second) types_all.push_back(it.first->first);
+            text_hashed[i] = it.first->second;
+        }
+        texts_hashed[h] = text_hashed;
+    }
+    texts_hashed.attr("types") = as_utf8(types_all);
+    return texts_hashed;
+}
+
+// Replace the type IDs of tokens by new IDs, as when types that become
+// identical after stemming or case folding are merged. ids_new gives the new
+// ID of each type; padding is kept as padding.
+// [[Rcpp::export]]
+List recode_types_hashed_cppl(List texts,
+                              const std::vector<int> &ids_new,
+                              const int thread){
+
+    int n_types = ids_new.size();
+    std::vector<unsigned int> map_ids(n_types + 1, 0);
+    for (int g = 0; g < n_types; g++) {
+        if (ids_new[g] < 0) stop("Invalid new type ID");
+        map_ids[g + 1] = ids_new[g];
+    }
+
+    int len = texts.size();
+    std::vector<const int*> ptrs(len);
+    std::vector<std::size_t> lens(len);
+    for (int h = 0; h < len; h++) {
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (std::size_t i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    // Only documents in which some ID changes are recoded
+    Texts texts_temp(len);
+    std::vector<char> changes(len, false);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 16)
+    #endif
+    for (int h = 0; h < len; h++) {
+        std::size_t i = 0;
+        while (i < lens[h] && map_ids[ptrs[h][i]] == (unsigned int)ptrs[h][i]) i++;
+        if (i == lens[h]) continue;
+        changes[h] = true;
+        Text &text = texts_temp[h];
+        text.resize(lens[h]);
+        for (std::size_t j = 0; j < lens[h]; j++) text[j] = map_ids[ptrs[h][j]];
+    }
+
+    List texts_recoded(len);
+    for (int h = 0; h < len; h++) {
+        if (changes[h]) {
+            texts_recoded[h] = as_integer(texts_temp[h]);
+            Text().swap(texts_temp[h]);
+        } else {
+            texts_recoded[h] = share(texts[h]); // unchanged texts are not copied
+        }
+    }
+    return texts_recoded;
+}
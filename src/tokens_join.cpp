@@ -1,5 +1,12 @@
 #include <Rcpp.h>
 #include <vector>
+#include "quanteda.h"
+#include "profile.h"
+#include <algorithm>
+#include <numeric>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace Rcpp;
 
@@ -72,23 +79,81 @@ void join_tokens_cpp(CharacterVector tokens,
   }
 }
 
+// Join sequences in a document, taking the longest match at each position
+bool join_tokens_hashed(const int *text,
+                        const std::size_t &len_text,
+                        const TrieSequences &trie,
+                        Text &text_joined){
+  
+  bool change = false;
+  std::size_t i = 0;
+  while (i < len_text){
+    int id_join;
+    std::size_t len_match = trie.match_longest(text, i, len_text, id_join);
+    if(len_match > 0){
+      if(!change) text_joined.assign(text, text + i); // copy only texts to be changed
+      text_joined.push_back(id_join);
+      i += len_match;
+      change = true;
+    }else{
+      if(change) text_joined.push_back(text[i]);
+      i++;
+    }
+  }
+  return change;
+}
+
+// Join all the sequences in one pass over each document
 // [[Rcpp::export]]
-void join_tokens_cppl(List texts, 
-                      const std::vector<bool> &flags,
-                      const CharacterVector &tokens_join,
-                      const String &delim){
-  //List texts(x);
-  //List texts = clone(texts_original);
+List join_tokens_hashed_cppl(List texts, 
+                             const List &seqs,
+                             const std::vector<int> &ids_join,
+                             const int thread){
+  
+  PROFILE_CALL("join_tokens_hashed_cppl");
+  PROFILE_STAGE("index");
+  TrieSequences trie;
+  for (int g = 0; g < seqs.size(); g++){
+    Text seq = as_text(seqs[g]);
+    if(seq.size() > 1) trie.insert(seq, ids_join[g]);
+  }
+  
   int len = texts.size();
-  if(flags.size() != len){
-    Rcout << "Invalid flag is given\n";
-    return;
+  std::vector<const int*> ptrs(len);
+  std::vector<std::size_t> lens(len);
+  for (int h = 0; h < len; h++){
+    SEXP text = texts[h];
+    ptrs[h] = INTEGER(text);
+    lens[h] = LENGTH(text);
   }
+  
+  PROFILE_COUNT("sequences", seqs.size());
+  PROFILE_COUNT("trie_nodes", trie.size());
+  
+  // Documents are processed in parallel without R's API
+  PROFILE_STAGE("join");
+  Texts texts_temp(len);
+  std::vector<char> changes(len, false);
+  #ifdef _OPENMP
+  #pragma omp parallel for num_threads(thread) schedule(dynamic, 16)
+  #endif
   for (int h = 0; h < len; h++){
-    if(flags[h]){
-      //Rcout << "Text " << h << "\n";
-      join_tokens_cpp(texts[h], tokens_join, delim);
+    changes[h] = join_tokens_hashed(ptrs[h], lens[h], trie, texts_temp[h]);
+  }
+  PROFILE_COUNT("documents", len);
+  PROFILE_COUNT("tokens_scanned", std::accumulate(lens.begin(), lens.end(), 0.0));
+  PROFILE_COUNT("documents_changed", std::count(changes.begin(), changes.end(), true));
+  
+  // Write back to R's memory on the main thread
+  PROFILE_STAGE("write");
+  List texts_joined(len);
+  for (int h = 0; h < len; h++){
+    if(changes[h]){
+      texts_joined[h] = as_integer(texts_temp[h]);
+      Text().swap(texts_temp[h]);
+    }else{
+      texts_joined[h] = share(texts[h]); // unchanged texts are not copied
     }
   }
+  return texts_joined;
 }
-
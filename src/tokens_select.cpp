@@ -1,63 +1,224 @@
 #include <Rcpp.h>
-#include <set>
 #include <vector>
+#include <algorithm>
 // [[Rcpp::plugins(cpp11)]]
 #include <unordered_set>
+#include "quanteda.h"
+#include "profile.h"
+#include <numeric>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 using namespace Rcpp;
 
 
+// Select tokens of a document as pointers to R's strings, so that it can be
+// done without calling R's API. Returns whether any token was removed.
+bool select_tokens(const std::vector<SEXP> &text,
+                   const std::unordered_set<SEXP> &set_types,
+                   const bool &remove,
+                   const bool &spacer,
+                   std::vector<SEXP> &text_selected,
+                   const SEXP &blank){
+  
+  bool change = false;
+  text_selected.reserve(text.size());
+  for (std::size_t i = 0; i < text.size(); i++){
+    bool is_in = set_types.find(text[i]) != set_types.end();
+    if(is_in == remove){
+      if(spacer) text_selected.push_back(blank);
+      change = true;
+    }else{
+      text_selected.push_back(text[i]);
+    }
+  }
+  return change;
+}
+
+// The same text in another encoding is another string in R's cache, so each
+// type is also added in UTF-8, native and latin1 encodings where it can be
+// represented in them. The strings made are kept in variants to be protected.
+void insert_encodings(SEXP type,
+                      std::unordered_set<SEXP> &set_types,
+                      CharacterVector &variants,
+                      int &n_variants){
+  
+  set_types.insert(type);
+  const char *utf8 = Rf_translateCharUTF8(type);
+  bool ascii = true;
+  for (const char *c = utf8; *c && ascii; c++) ascii = (unsigned char)*c < 0x80;
+  if(ascii) return; // ASCII strings are never marked
+  std::string str(utf8);
+  SEXP type_utf8 = Rf_mkCharCE(str.c_str(), CE_UTF8);
+  SET_STRING_ELT(variants, n_variants++, type_utf8);
+  SEXP type_native = Rf_mkCharCE(Rf_translateChar(type_utf8), CE_NATIVE);
+  SET_STRING_ELT(variants, n_variants++, type_native);
+  SEXP type_latin1 = Rf_mkCharCE(Rf_reEnc(str.c_str(), CE_UTF8, CE_LATIN1, 1), CE_LATIN1);
+  SET_STRING_ELT(variants, n_variants++, type_latin1);
+  set_types.insert(type_utf8);
+  if(str == Rf_translateCharUTF8(type_native)) set_types.insert(type_native);
+  if(str == Rf_translateCharUTF8(type_latin1)) set_types.insert(type_latin1);
+}
+
+// Strings are compared by their address in R's global string cache, so types 
+// must be taken from the texts themselves. A new list is returned, in which
+// documents without tokens removed are shared with texts rather than copied.
 // [[Rcpp::export]]
-void select_tokens_cppl(Rcpp::List texts,
+List select_tokens_cppl(const List &texts,
                         const std::vector<bool> &flags,
-                        const std::vector< std::string > &types,
+                        const CharacterVector &types,
                         const bool &remove,
-                        const bool &spacer){
+                        const bool &spacer,
+                        const int thread){
   
+  PROFILE_CALL("select_tokens_cppl");
+  PROFILE_STAGE("index");
   int len = texts.size();
-  if(flags.size() != len){
-    Rcout << "Invalid flag is given\n";
-    return;
+  if((int)flags.size() != len) stop("Invalid flag is given");
+  
+  std::unordered_set<SEXP> set_types;
+  CharacterVector variants(3 * types.size());
+  int n_variants = 0;
+  for (int g = 0; g < types.size(); g++) insert_encodings(STRING_ELT(types, g), set_types, variants, n_variants);
+  SEXP blank = R_BlankString;
+  PROFILE_COUNT("types", set_types.size());
+  PROFILE_COUNT("types_load_factor", set_types.load_factor());
+  
+  // Copy the texts to be scanned out of R's memory on the main thread
+  PROFILE_STAGE("copy");
+  std::vector< std::vector<SEXP> > texts_temp(len);
+  for (int h = 0; h < len; h++){
+    if(!flags[h]) continue;
+    SEXP text = texts[h];
+    int len_text = LENGTH(text);
+    texts_temp[h].resize(len_text);
+    for (int i = 0; i < len_text; i++) texts_temp[h][i] = STRING_ELT(text, i);
+  }
+  
+  PROFILE_COUNT("documents_scanned", std::count(flags.begin(), flags.end(), true));
+  PROFILE_COUNT("documents_skipped", std::count(flags.begin(), flags.end(), false));
+  
+  PROFILE_STAGE("select");
+  std::vector< std::vector<SEXP> > texts_selected(len);
+  std::vector<char> changes(len, false);
+  std::size_t n_tokens = 0;
+  #ifdef _OPENMP
+  #pragma omp parallel for num_threads(thread) schedule(dynamic, 16) reduction(+:n_tokens)
+  #endif
+  for (int h = 0; h < len; h++){
+    if(!flags[h]) continue;
+    n_tokens += texts_temp[h].size();
+    changes[h] = select_tokens(texts_temp[h], set_types, remove, spacer, texts_selected[h], blank);
+    std::vector<SEXP>().swap(texts_temp[h]);
+    if(!changes[h]) std::vector<SEXP>().swap(texts_selected[h]);
   }
+  PROFILE_COUNT("tokens_scanned", n_tokens);
+  PROFILE_COUNT("documents_changed", std::count(changes.begin(), changes.end(), true));
   
-  //Rcpp::List texts(x);
-  std::unordered_set<std::string> set_types (types.begin(), types.end());
-  for (int h=0; h < len; h++){
-    //Rcout << "Text " << h << "\n";
-    Rcpp::CharacterVector text = texts[h];
-    
+  // Write to R's memory on the main thread
+  PROFILE_STAGE("write");
+  List result(len);
+  for (int h = 0; h < len; h++){
+    SEXP text = texts[h];
     if(!flags[h]){
-      if(!remove){
-        if(spacer){
-          texts[h] = Rcpp::CharacterVector(text.size()); // all empty in origina length
-        }else{
-          texts[h] = Rcpp::CharacterVector(); // nothing left
-        }
-      }
-      //Rcout << "Skip " << h << "\n";
-      continue;
-    }
-
-    Rcpp::CharacterVector text_temp(text.size()); // make vector in the same length as original
-    int j = 0;
-    for (int i=0; i < text_temp.size(); i++){
-      Rcpp::String token = text[i];
-      bool is_in = set_types.find(token) != set_types.end();
-      if(is_in == remove){
-        //Rcout << "Match " << i << ' ' << token.get_cstring() << "\n";
-        if(spacer){
-          text_temp[j] = "";
-          j++;
-        }
+      if(remove){
+        result[h] = share(text); // nothing to remove
+      }else if(spacer){
+        result[h] = Rcpp::CharacterVector(LENGTH(text)); // all empty in original length
       }else{
-        text_temp[j] = token;
-        j++;
+        result[h] = Rcpp::CharacterVector(); // nothing left
       }
+    }else if(!changes[h]){
+      result[h] = share(text); // unchanged texts are not copied
+    }else{
+      int len_selected = texts_selected[h].size();
+      Rcpp::CharacterVector text_selected(len_selected);
+      for (int i = 0; i < len_selected; i++) SET_STRING_ELT(text_selected, i, texts_selected[h][i]);
+      std::vector<SEXP>().swap(texts_selected[h]);
+      result[h] = text_selected;
     }
-    if(j == 0){
-      texts[h] = Rcpp::CharacterVector(); // nothing left
+  }
+  return result;
+}
+
+// Select tokens using a table of types to be selected indexed by ID
+void select_tokens_hashed(const int *text,
+                          const std::size_t &len_text,
+                          const std::vector<bool> &is_type,
+                          const bool &remove,
+                          const bool &spacer,
+                          Text &text_selected,
+                          bool &change){
+  
+  text_selected.reserve(len_text);
+  change = false;
+  for (std::size_t i = 0; i < len_text; i++){
+    bool is_in = is_type[text[i]];
+    if(is_in == remove){
+      if(spacer) text_selected.push_back(0);
+      change = true;
     }else{
-      texts[h] = text_temp[seq(0, j - 1)];
+      text_selected.push_back(text[i]);
     }
   }
 }
 
+// [[Rcpp::export]]
+List select_tokens_hashed_cppl(List texts,
+                               const std::vector<int> &types,
+                               const int n_types,
+                               const bool &remove,
+                               const bool &spacer,
+                               const int thread){
+  
+  PROFILE_CALL("select_tokens_hashed_cppl");
+  PROFILE_STAGE("index");
+  int len = texts.size();
+  std::vector<const int*> ptrs(len);
+  std::vector<std::size_t> lens(len);
+  for (int h = 0; h < len; h++){
+    SEXP text = texts[h];
+    ptrs[h] = INTEGER(text);
+    lens[h] = LENGTH(text);
+    for (std::size_t i = 0; i < lens[h]; i++){
+      if(ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+    }
+  }
+  std::vector<bool> is_type(n_types + 1, false);
+  for (std::size_t g = 0; g < types.size(); g++){
+    if(types[g] < 0 || types[g] > n_types) stop("Invalid type ID to select");
+    if(types[g] > 0) is_type[types[g]] = true; // padding is never selected
+  }
+  
+  // Documents are processed in parallel without R's API
+  PROFILE_STAGE("select");
+  Texts texts_temp(len);
+  std::vector<char> changes(len, false);
+  #ifdef _OPENMP
+  #pragma omp parallel for num_threads(thread) schedule(dynamic, 16)
+  #endif
+  for (int h = 0; h < len; h++){
+    bool change;
+    select_tokens_hashed(ptrs[h], lens[h], is_type, remove, spacer, texts_temp[h], change);
+    changes[h] = change;
+    if(!change) Text().swap(texts_temp[h]);
+  }
+  
+  PROFILE_COUNT("documents", len);
+  PROFILE_COUNT("tokens_scanned", std::accumulate(lens.begin(), lens.end(), 0.0));
+  PROFILE_COUNT("documents_changed", std::count(changes.begin(), changes.end(), true));
+  PROFILE_COUNT("types_selected", std::count(is_type.begin(), is_type.end(), true));
+  
+  // Write back to R's memory on the main thread
+  PROFILE_STAGE("write");
+  List texts_selected(len);
+  for (int h = 0; h < len; h++){
+    if(changes[h]){
+      texts_selected[h] = as_integer(texts_temp[h]);
+      Text().swap(texts_temp[h]);
+    }else{
+      texts_selected[h] = share(texts[h]); // unchanged texts are not copied
+    }
+  }
+  return texts_selected;
+}
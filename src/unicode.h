@@ -0,0 +1,464 @@
+// Classes of Unicode characters used by the native tokenizer, generated from
+// the Unicode Character Database (version 14.0.0). White space is the White_Space
+// property; word characters are letters, marks, letter numbers and joiners,
+// which with decimal digits and connector punctuation make \w in ICU regular
+// expressions.
+#ifndef QUANTEDA_UNICODE
+#define QUANTEDA_UNICODE
+
+#include <cstdint>
+#include <algorithm>
+
+namespace unicode {
+
+enum CharClass { OTHER, SPACE, WORD, DIGIT, CONNECTOR, DASH, PUNCT, SYMBOL };
+
+const CharClass ascii_classes[128] = {
+    OTHER, OTHER, OTHER, OTHER, OTHER, OTHER, OTHER, OTHER,
+    OTHER, SPACE, SPACE, SPACE, SPACE, SPACE, OTHER, OTHER,
+    OTHER, OTHER, OTHER, OTHER, OTHER, OTHER, OTHER, OTHER,
+    OTHER, OTHER, OTHER, OTHER, OTHER, OTHER, OTHER, OTHER,
+    SPACE, PUNCT, PUNCT, PUNCT, SYMBOL, PUNCT, PUNCT, PUNCT,
+    PUNCT, PUNCT, PUNCT, SYMBOL, PUNCT, DASH, PUNCT, PUNCT,
+    DIGIT, DIGIT, DIGIT, DIGIT, DIGIT, DIGIT, DIGIT, DIGIT,
+    DIGIT, DIGIT, PUNCT, PUNCT, SYMBOL, SYMBOL, SYMBOL, PUNCT,
+    PUNCT, WORD, WORD, WORD, WORD, WORD, WORD, WORD,
+    WORD, WORD, WORD, WORD, WORD, WORD, WORD, WORD,
+    WORD, WORD, WORD, WORD, WORD, WORD, WORD, WORD,
+    WORD, WORD, WORD, PUNCT, PUNCT, PUNCT, SYMBOL, CONNECTOR,
+    SYMBOL, WORD, WORD, WORD, WORD, WORD, WORD, WORD,
+    WORD, WORD, WORD, WORD, WORD, WORD, WORD, WORD,
+    WORD, WORD, WORD, WORD, WORD, WORD, WORD, WORD,
+    WORD, WORD, WORD, PUNCT, SYMBOL, PUNCT, SYMBOL, OTHER,
+};
+
+struct CharRange { uint32_t first, last; CharClass type; };
+
+// Ranges of characters from U+0080 that are not OTHER, sorted
+const CharRange ranges[] = {
+    {0x0085, 0x0085, SPACE}, {0x00A0, 0x00A0, SPACE}, {0x00A1, 0x00A1, PUNCT},
+    {0x00A2, 0x00A6, SYMBOL}, {0x00A7, 0x00A7, PUNCT}, {0x00A8, 0x00A9, SYMBOL},
+    {0x00AA, 0x00AA, WORD}, {0x00AB, 0x00AB, PUNCT}, {0x00AC, 0x00AC, SYMBOL},
+    {0x00AE, 0x00B1, SYMBOL}, {0x00B4, 0x00B4, SYMBOL}, {0x00B5, 0x00B5, WORD},
+    {0x00B6, 0x00B7, PUNCT}, {0x00B8, 0x00B8, SYMBOL}, {0x00BA, 0x00BA, WORD},
+    {0x00BB, 0x00BB, PUNCT}, {0x00BF, 0x00BF, PUNCT}, {0x00C0, 0x00D6, WORD},
+    {0x00D7, 0x00D7, SYMBOL}, {0x00D8, 0x00F6, WORD}, {0x00F7, 0x00F7, SYMBOL},
+    {0x00F8, 0x02C1, WORD}, {0x02C2, 0x02C5, SYMBOL}, {0x02C6, 0x02D1, WORD},
+    {0x02D2, 0x02DF, SYMBOL}, {0x02E0, 0x02E4, WORD}, {0x02E5, 0x02EB, SYMBOL},
+    {0x02EC, 0x02EC, WORD}, {0x02ED, 0x02ED, SYMBOL}, {0x02EE, 0x02EE, WORD},
+    {0x02EF, 0x02FF, SYMBOL}, {0x0300, 0x0374, WORD}, {0x0375, 0x0375, SYMBOL},
+    {0x0376, 0x0377, WORD}, {0x037A, 0x037D, WORD}, {0x037E, 0x037E, PUNCT},
+    {0x037F, 0x037F, WORD}, {0x0384, 0x0385, SYMBOL}, {0x0386, 0x0386, WORD},
+    {0x0387, 0x0387, PUNCT}, {0x0388, 0x038A, WORD}, {0x038C, 0x038C, WORD},
+    {0x038E, 0x03A1, WORD}, {0x03A3, 0x03F5, WORD}, {0x03F6, 0x03F6, SYMBOL},
+    {0x03F7, 0x0481, WORD}, {0x0482, 0x0482, SYMBOL}, {0x0483, 0x052F, WORD},
+    {0x0531, 0x0556, WORD}, {0x0559, 0x0559, WORD}, {0x055A, 0x055F, PUNCT},
+    {0x0560, 0x0588, WORD}, {0x0589, 0x0589, PUNCT}, {0x058A, 0x058A, DASH},
+    {0x058D, 0x058F, SYMBOL}, {0x0591, 0x05BD, WORD}, {0x05BE, 0x05BE, DASH},
+    {0x05BF, 0x05BF, WORD}, {0x05C0, 0x05C0, PUNCT}, {0x05C1, 0x05C2, WORD},
+    {0x05C3, 0x05C3, PUNCT}, {0x05C4, 0x05C5, WORD}, {0x05C6, 0x05C6, PUNCT},
+    {0x05C7, 0x05C7, WORD}, {0x05D0, 0x05EA, WORD}, {0x05EF, 0x05F2, WORD},
+    {0x05F3, 0x05F4, PUNCT}, {0x0606, 0x0608, SYMBOL}, {0x0609, 0x060A, PUNCT},
+    {0x060B, 0x060B, SYMBOL}, {0x060C, 0x060D, PUNCT}, {0x060E, 0x060F, SYMBOL},
+    {0x0610, 0x061A, WORD}, {0x061B, 0x061B, PUNCT}, {0x061D, 0x061F, PUNCT},
+    {0x0620, 0x065F, WORD}, {0x0660, 0x0669, DIGIT}, {0x066A, 0x066D, PUNCT},
+    {0x066E, 0x06D3, WORD}, {0x06D4, 0x06D4, PUNCT}, {0x06D5, 0x06DC, WORD},
+    {0x06DE, 0x06DE, SYMBOL}, {0x06DF, 0x06E8, WORD}, {0x06E9, 0x06E9, SYMBOL},
+    {0x06EA, 0x06EF, WORD}, {0x06F0, 0x06F9, DIGIT}, {0x06FA, 0x06FC, WORD},
+    {0x06FD, 0x06FE, SYMBOL}, {0x06FF, 0x06FF, WORD}, {0x0700, 0x070D, PUNCT},
+    {0x0710, 0x074A, WORD}, {0x074D, 0x07B1, WORD}, {0x07C0, 0x07C9, DIGIT},
+    {0x07CA, 0x07F5, WORD}, {0x07F6, 0x07F6, SYMBOL}, {0x07F7, 0x07F9, PUNCT},
+    {0x07FA, 0x07FA, WORD}, {0x07FD, 0x07FD, WORD}, {0x07FE, 0x07FF, SYMBOL},
+    {0x0800, 0x082D, WORD}, {0x0830, 0x083E, PUNCT}, {0x0840, 0x085B, WORD},
+    {0x085E, 0x085E, PUNCT}, {0x0860, 0x086A, WORD}, {0x0870, 0x0887, WORD},
+    {0x0888, 0x0888, SYMBOL}, {0x0889, 0x088E, WORD}, {0x0898, 0x08E1, WORD},
+    {0x08E3, 0x0963, WORD}, {0x0964, 0x0965, PUNCT}, {0x0966, 0x096F, DIGIT},
+    {0x0970, 0x0970, PUNCT}, {0x0971, 0x0983, WORD}, {0x0985, 0x098C, WORD},
+    {0x098F, 0x0990, WORD}, {0x0993, 0x09A8, WORD}, {0x09AA, 0x09B0, WORD},
+    {0x09B2, 0x09B2, WORD}, {0x09B6, 0x09B9, WORD}, {0x09BC, 0x09C4, WORD},
+    {0x09C7, 0x09C8, WORD}, {0x09CB, 0x09CE, WORD}, {0x09D7, 0x09D7, WORD},
+    {0x09DC, 0x09DD, WORD}, {0x09DF, 0x09E3, WORD}, {0x09E6, 0x09EF, DIGIT},
+    {0x09F0, 0x09F1, WORD}, {0x09F2, 0x09F3, SYMBOL}, {0x09FA, 0x09FB, SYMBOL},
+    {0x09FC, 0x09FC, WORD}, {0x09FD, 0x09FD, PUNCT}, {0x09FE, 0x09FE, WORD},
+    {0x0A01, 0x0A03, WORD}, {0x0A05, 0x0A0A, WORD}, {0x0A0F, 0x0A10, WORD},
+    {0x0A13, 0x0A28, WORD}, {0x0A2A, 0x0A30, WORD}, {0x0A32, 0x0A33, WORD},
+    {0x0A35, 0x0A36, WORD}, {0x0A38, 0x0A39, WORD}, {0x0A3C, 0x0A3C, WORD},
+    {0x0A3E, 0x0A42, WORD}, {0x0A47, 0x0A48, WORD}, {0x0A4B, 0x0A4D, WORD},
+    {0x0A51, 0x0A51, WORD}, {0x0A59, 0x0A5C, WORD}, {0x0A5E, 0x0A5E, WORD},
+    {0x0A66, 0x0A6F, DIGIT}, {0x0A70, 0x0A75, WORD}, {0x0A76, 0x0A76, PUNCT},
+    {0x0A81, 0x0A83, WORD}, {0x0A85, 0x0A8D, WORD}, {0x0A8F, 0x0A91, WORD},
+    {0x0A93, 0x0AA8, WORD}, {0x0AAA, 0x0AB0, WORD}, {0x0AB2, 0x0AB3, WORD},
+    {0x0AB5, 0x0AB9, WORD}, {0x0ABC, 0x0AC5, WORD}, {0x0AC7, 0x0AC9, WORD},
+    {0x0ACB, 0x0ACD, WORD}, {0x0AD0, 0x0AD0, WORD}, {0x0AE0, 0x0AE3, WORD},
+    {0x0AE6, 0x0AEF, DIGIT}, {0x0AF0, 0x0AF0, PUNCT}, {0x0AF1, 0x0AF1, SYMBOL},
+    {0x0AF9, 0x0AFF, WORD}, {0x0B01, 0x0B03, WORD}, {0x0B05, 0x0B0C, WORD},
+    {0x0B0F, 0x0B10, WORD}, {0x0B13, 0x0B28, WORD}, {0x0B2A, 0x0B30, WORD},
+    {0x0B32, 0x0B33, WORD}, {0x0B35, 0x0B39, WORD}, {0x0B3C, 0x0B44, WORD},
+    {0x0B47, 0x0B48, WORD}, {0x0B4B, 0x0B4D, WORD}, {0x0B55, 0x0B57, WORD},
+    {0x0B5C, 0x0B5D, WORD}, {0x0B5F, 0x0B63, WORD}, {0x0B66, 0x0B6F, DIGIT},
+    {0x0B70, 0x0B70, SYMBOL}, {0x0B71, 0x0B71, WORD}, {0x0B82, 0x0B83, WORD},
+    {0x0B85, 0x0B8A, WORD}, {0x0B8E, 0x0B90, WORD}, {0x0B92, 0x0B95, WORD},
+    {0x0B99, 0x0B9A, WORD}, {0x0B9C, 0x0B9C, WORD}, {0x0B9E, 0x0B9F, WORD},
+    {0x0BA3, 0x0BA4, WORD}, {0x0BA8, 0x0BAA, WORD}, {0x0BAE, 0x0BB9, WORD},
+    {0x0BBE, 0x0BC2, WORD}, {0x0BC6, 0x0BC8, WORD}, {0x0BCA, 0x0BCD, WORD},
+    {0x0BD0, 0x0BD0, WORD}, {0x0BD7, 0x0BD7, WORD}, {0x0BE6, 0x0BEF, DIGIT},
+    {0x0BF3, 0x0BFA, SYMBOL}, {0x0C00, 0x0C0C, WORD}, {0x0C0E, 0x0C10, WORD},
+    {0x0C12, 0x0C28, WORD}, {0x0C2A, 0x0C39, WORD}, {0x0C3C, 0x0C44, WORD},
+    {0x0C46, 0x0C48, WORD}, {0x0C4A, 0x0C4D, WORD}, {0x0C55, 0x0C56, WORD},
+    {0x0C58, 0x0C5A, WORD}, {0x0C5D, 0x0C5D, WORD}, {0x0C60, 0x0C63, WORD},
+    {0x0C66, 0x0C6F, DIGIT}, {0x0C77, 0x0C77, PUNCT}, {0x0C7F, 0x0C7F, SYMBOL},
+    {0x0C80, 0x0C83, WORD}, {0x0C84, 0x0C84, PUNCT}, {0x0C85, 0x0C8C, WORD},
+    {0x0C8E, 0x0C90, WORD}, {0x0C92, 0x0CA8, WORD}, {0x0CAA, 0x0CB3, WORD},
+    {0x0CB5, 0x0CB9, WORD}, {0x0CBC, 0x0CC4, WORD}, {0x0CC6, 0x0CC8, WORD},
+    {0x0CCA, 0x0CCD, WORD}, {0x0CD5, 0x0CD6, WORD}, {0x0CDD, 0x0CDE, WORD},
+    {0x0CE0, 0x0CE3, WORD}, {0x0CE6, 0x0CEF, DIGIT}, {0x0CF1, 0x0CF2, WORD},
+    {0x0D00, 0x0D0C, WORD}, {0x0D0E, 0x0D10, WORD}, {0x0D12, 0x0D44, WORD},
+    {0x0D46, 0x0D48, WORD}, {0x0D4A, 0x0D4E, WORD}, {0x0D4F, 0x0D4F, SYMBOL},
+    {0x0D54, 0x0D57, WORD}, {0x0D5F, 0x0D63, WORD}, {0x0D66, 0x0D6F, DIGIT},
+    {0x0D79, 0x0D79, SYMBOL}, {0x0D7A, 0x0D7F, WORD}, {0x0D81, 0x0D83, WORD},
+    {0x0D85, 0x0D96, WORD}, {0x0D9A, 0x0DB1, WORD}, {0x0DB3, 0x0DBB, WORD},
+    {0x0DBD, 0x0DBD, WORD}, {0x0DC0, 0x0DC6, WORD}, {0x0DCA, 0x0DCA, WORD},
+    {0x0DCF, 0x0DD4, WORD}, {0x0DD6, 0x0DD6, WORD}, {0x0DD8, 0x0DDF, WORD},
+    {0x0DE6, 0x0DEF, DIGIT}, {0x0DF2, 0x0DF3, WORD}, {0x0DF4, 0x0DF4, PUNCT},
+    {0x0E01, 0x0E3A, WORD}, {0x0E3F, 0x0E3F, SYMBOL}, {0x0E40, 0x0E4E, WORD},
+    {0x0E4F, 0x0E4F, PUNCT}, {0x0E50, 0x0E59, DIGIT}, {0x0E5A, 0x0E5B, PUNCT},
+    {0x0E81, 0x0E82, WORD}, {0x0E84, 0x0E84, WORD}, {0x0E86, 0x0E8A, WORD},
+    {0x0E8C, 0x0EA3, WORD}, {0x0EA5, 0x0EA5, WORD}, {0x0EA7, 0x0EBD, WORD},
+    {0x0EC0, 0x0EC4, WORD}, {0x0EC6, 0x0EC6, WORD}, {0x0EC8, 0x0ECD, WORD},
+    {0x0ED0, 0x0ED9, DIGIT}, {0x0EDC, 0x0EDF, WORD}, {0x0F00, 0x0F00, WORD},
+    {0x0F01, 0x0F03, SYMBOL}, {0x0F04, 0x0F12, PUNCT}, {0x0F13, 0x0F13, SYMBOL},
+    {0x0F14, 0x0F14, PUNCT}, {0x0F15, 0x0F17, SYMBOL}, {0x0F18, 0x0F19, WORD},
+    {0x0F1A, 0x0F1F, SYMBOL}, {0x0F20, 0x0F29, DIGIT}, {0x0F34, 0x0F34, SYMBOL},
+    {0x0F35, 0x0F35, WORD}, {0x0F36, 0x0F36, SYMBOL}, {0x0F37, 0x0F37, WORD},
+    {0x0F38, 0x0F38, SYMBOL}, {0x0F39, 0x0F39, WORD}, {0x0F3A, 0x0F3D, PUNCT},
+    {0x0F3E, 0x0F47, WORD}, {0x0F49, 0x0F6C, WORD}, {0x0F71, 0x0F84, WORD},
+    {0x0F85, 0x0F85, PUNCT}, {0x0F86, 0x0F97, WORD}, {0x0F99, 0x0FBC, WORD},
+    {0x0FBE, 0x0FC5, SYMBOL}, {0x0FC6, 0x0FC6, WORD}, {0x0FC7, 0x0FCC, SYMBOL},
+    {0x0FCE, 0x0FCF, SYMBOL}, {0x0FD0, 0x0FD4, PUNCT}, {0x0FD5, 0x0FD8, SYMBOL},
+    {0x0FD9, 0x0FDA, PUNCT}, {0x1000, 0x103F, WORD}, {0x1040, 0x1049, DIGIT},
+    {0x104A, 0x104F, PUNCT}, {0x1050, 0x108F, WORD}, {0x1090, 0x1099, DIGIT},
+    {0x109A, 0x109D, WORD}, {0x109E, 0x109F, SYMBOL}, {0x10A0, 0x10C5, WORD},
+    {0x10C7, 0x10C7, WORD}, {0x10CD, 0x10CD, WORD}, {0x10D0, 0x10FA, WORD},
+    {0x10FB, 0x10FB, PUNCT}, {0x10FC, 0x1248, WORD}, {0x124A, 0x124D, WORD},
+    {0x1250, 0x1256, WORD}, {0x1258, 0x1258, WORD}, {0x125A, 0x125D, WORD},
+    {0x1260, 0x1288, WORD}, {0x128A, 0x128D, WORD}, {0x1290, 0x12B0, WORD},
+    {0x12B2, 0x12B5, WORD}, {0x12B8, 0x12BE, WORD}, {0x12C0, 0x12C0, WORD},
+    {0x12C2, 0x12C5, WORD}, {0x12C8, 0x12D6, WORD}, {0x12D8, 0x1310, WORD},
+    {0x1312, 0x1315, WORD}, {0x1318, 0x135A, WORD}, {0x135D, 0x135F, WORD},
+    {0x1360, 0x1368, PUNCT}, {0x1380, 0x138F, WORD}, {0x1390, 0x1399, SYMBOL},
+    {0x13A0, 0x13F5, WORD}, {0x13F8, 0x13FD, WORD}, {0x1400, 0x1400, DASH},
+    {0x1401, 0x166C, WORD}, {0x166D, 0x166D, SYMBOL}, {0x166E, 0x166E, PUNCT},
+    {0x166F, 0x167F, WORD}, {0x1680, 0x1680, SPACE}, {0x1681, 0x169A, WORD},
+    {0x169B, 0x169C, PUNCT}, {0x16A0, 0x16EA, WORD}, {0x16EB, 0x16ED, PUNCT},
+    {0x16EE, 0x16F8, WORD}, {0x1700, 0x1715, WORD}, {0x171F, 0x1734, WORD},
+    {0x1735, 0x1736, PUNCT}, {0x1740, 0x1753, WORD}, {0x1760, 0x176C, WORD},
+    {0x176E, 0x1770, WORD}, {0x1772, 0x1773, WORD}, {0x1780, 0x17D3, WORD},
+    {0x17D4, 0x17D6, PUNCT}, {0x17D7, 0x17D7, WORD}, {0x17D8, 0x17DA, PUNCT},
+    {0x17DB, 0x17DB, SYMBOL}, {0x17DC, 0x17DD, WORD}, {0x17E0, 0x17E9, DIGIT},
+    {0x1800, 0x1805, PUNCT}, {0x1806, 0x1806, DASH}, {0x1807, 0x180A, PUNCT},
+    {0x180B, 0x180D, WORD}, {0x180F, 0x180F, WORD}, {0x1810, 0x1819, DIGIT},
+    {0x1820, 0x1878, WORD}, {0x1880, 0x18AA, WORD}, {0x18B0, 0x18F5, WORD},
+    {0x1900, 0x191E, WORD}, {0x1920, 0x192B, WORD}, {0x1930, 0x193B, WORD},
+    {0x1940, 0x1940, SYMBOL}, {0x1944, 0x1945, PUNCT}, {0x1946, 0x194F, DIGIT},
+    {0x1950, 0x196D, WORD}, {0x1970, 0x1974, WORD}, {0x1980, 0x19AB, WORD},
+    {0x19B0, 0x19C9, WORD}, {0x19D0, 0x19D9, DIGIT}, {0x19DE, 0x19FF, SYMBOL},
+    {0x1A00, 0x1A1B, WORD}, {0x1A1E, 0x1A1F, PUNCT}, {0x1A20, 0x1A5E, WORD},
+    {0x1A60, 0x1A7C, WORD}, {0x1A7F, 0x1A7F, WORD}, {0x1A80, 0x1A89, DIGIT},
+    {0x1A90, 0x1A99, DIGIT}, {0x1AA0, 0x1AA6, PUNCT}, {0x1AA7, 0x1AA7, WORD},
+    {0x1AA8, 0x1AAD, PUNCT}, {0x1AB0, 0x1ACE, WORD}, {0x1B00, 0x1B4C, WORD},
+    {0x1B50, 0x1B59, DIGIT}, {0x1B5A, 0x1B60, PUNCT}, {0x1B61, 0x1B6A, SYMBOL},
+    {0x1B6B, 0x1B73, WORD}, {0x1B74, 0x1B7C, SYMBOL}, {0x1B7D, 0x1B7E, PUNCT},
+    {0x1B80, 0x1BAF, WORD}, {0x1BB0, 0x1BB9, DIGIT}, {0x1BBA, 0x1BF3, WORD},
+    {0x1BFC, 0x1BFF, PUNCT}, {0x1C00, 0x1C37, WORD}, {0x1C3B, 0x1C3F, PUNCT},
+    {0x1C40, 0x1C49, DIGIT}, {0x1C4D, 0x1C4F, WORD}, {0x1C50, 0x1C59, DIGIT},
+    {0x1C5A, 0x1C7D, WORD}, {0x1C7E, 0x1C7F, PUNCT}, {0x1C80, 0x1C88, WORD},
+    {0x1C90, 0x1CBA, WORD}, {0x1CBD, 0x1CBF, WORD}, {0x1CC0, 0x1CC7, PUNCT},
+    {0x1CD0, 0x1CD2, WORD}, {0x1CD3, 0x1CD3, PUNCT}, {0x1CD4, 0x1CFA, WORD},
+    {0x1D00, 0x1F15, WORD}, {0x1F18, 0x1F1D, WORD}, {0x1F20, 0x1F45, WORD},
+    {0x1F48, 0x1F4D, WORD}, {0x1F50, 0x1F57, WORD}, {0x1F59, 0x1F59, WORD},
+    {0x1F5B, 0x1F5B, WORD}, {0x1F5D, 0x1F5D, WORD}, {0x1F5F, 0x1F7D, WORD},
+    {0x1F80, 0x1FB4, WORD}, {0x1FB6, 0x1FBC, WORD}, {0x1FBD, 0x1FBD, SYMBOL},
+    {0x1FBE, 0x1FBE, WORD}, {0x1FBF, 0x1FC1, SYMBOL}, {0x1FC2, 0x1FC4, WORD},
+    {0x1FC6, 0x1FCC, WORD}, {0x1FCD, 0x1FCF, SYMBOL}, {0x1FD0, 0x1FD3, WORD},
+    {0x1FD6, 0x1FDB, WORD}, {0x1FDD, 0x1FDF, SYMBOL}, {0x1FE0, 0x1FEC, WORD},
+    {0x1FED, 0x1FEF, SYMBOL}, {0x1FF2, 0x1FF4, WORD}, {0x1FF6, 0x1FFC, WORD},
+    {0x1FFD, 0x1FFE, SYMBOL}, {0x2000, 0x200A, SPACE}, {0x200C, 0x200D, WORD},
+    {0x2010, 0x2015, DASH}, {0x2016, 0x2027, PUNCT}, {0x2028, 0x2029, SPACE},
+    {0x202F, 0x202F, SPACE}, {0x2030, 0x203E, PUNCT}, {0x203F, 0x2040, CONNECTOR},
+    {0x2041, 0x2043, PUNCT}, {0x2044, 0x2044, SYMBOL}, {0x2045, 0x2051, PUNCT},
+    {0x2052, 0x2052, SYMBOL}, {0x2053, 0x2053, PUNCT}, {0x2054, 0x2054, CONNECTOR},
+    {0x2055, 0x205E, PUNCT}, {0x205F, 0x205F, SPACE}, {0x2071, 0x2071, WORD},
+    {0x207A, 0x207C, SYMBOL}, {0x207D, 0x207E, PUNCT}, {0x207F, 0x207F, WORD},
+    {0x208A, 0x208C, SYMBOL}, {0x208D, 0x208E, PUNCT}, {0x2090, 0x209C, WORD},
+    {0x20A0, 0x20C0, SYMBOL}, {0x20D0, 0x20F0, WORD}, {0x2100, 0x2101, SYMBOL},
+    {0x2102, 0x2102, WORD}, {0x2103, 0x2106, SYMBOL}, {0x2107, 0x2107, WORD},
+    {0x2108, 0x2109, SYMBOL}, {0x210A, 0x2113, WORD}, {0x2114, 0x2114, SYMBOL},
+    {0x2115, 0x2115, WORD}, {0x2116, 0x2118, SYMBOL}, {0x2119, 0x211D, WORD},
+    {0x211E, 0x2123, SYMBOL}, {0x2124, 0x2124, WORD}, {0x2125, 0x2125, SYMBOL},
+    {0x2126, 0x2126, WORD}, {0x2127, 0x2127, SYMBOL}, {0x2128, 0x2128, WORD},
+    {0x2129, 0x2129, SYMBOL}, {0x212A, 0x212D, WORD}, {0x212E, 0x212E, SYMBOL},
+    {0x212F, 0x2139, WORD}, {0x213A, 0x213B, SYMBOL}, {0x213C, 0x213F, WORD},
+    {0x2140, 0x2144, SYMBOL}, {0x2145, 0x2149, WORD}, {0x214A, 0x214D, SYMBOL},
+    {0x214E, 0x214E, WORD}, {0x214F, 0x214F, SYMBOL}, {0x2160, 0x2188, WORD},
+    {0x218A, 0x218B, SYMBOL}, {0x2190, 0x2307, SYMBOL}, {0x2308, 0x230B, PUNCT},
+    {0x230C, 0x2328, SYMBOL}, {0x2329, 0x232A, PUNCT}, {0x232B, 0x2426, SYMBOL},
+    {0x2440, 0x244A, SYMBOL}, {0x249C, 0x24E9, SYMBOL}, {0x2500, 0x2767, SYMBOL},
+    {0x2768, 0x2775, PUNCT}, {0x2794, 0x27C4, SYMBOL}, {0x27C5, 0x27C6, PUNCT},
+    {0x27C7, 0x27E5, SYMBOL}, {0x27E6, 0x27EF, PUNCT}, {0x27F0, 0x2982, SYMBOL},
+    {0x2983, 0x2998, PUNCT}, {0x2999, 0x29D7, SYMBOL}, {0x29D8, 0x29DB, PUNCT},
+    {0x29DC, 0x29FB, SYMBOL}, {0x29FC, 0x29FD, PUNCT}, {0x29FE, 0x2B73, SYMBOL},
+    {0x2B76, 0x2B95, SYMBOL}, {0x2B97, 0x2BFF, SYMBOL}, {0x2C00, 0x2CE4, WORD},
+    {0x2CE5, 0x2CEA, SYMBOL}, {0x2CEB, 0x2CF3, WORD}, {0x2CF9, 0x2CFC, PUNCT},
+    {0x2CFE, 0x2CFF, PUNCT}, {0x2D00, 0x2D25, WORD}, {0x2D27, 0x2D27, WORD},
+    {0x2D2D, 0x2D2D, WORD}, {0x2D30, 0x2D67, WORD}, {0x2D6F, 0x2D6F, WORD},
+    {0x2D70, 0x2D70, PUNCT}, {0x2D7F, 0x2D96, WORD}, {0x2DA0, 0x2DA6, WORD},
+    {0x2DA8, 0x2DAE, WORD}, {0x2DB0, 0x2DB6, WORD}, {0x2DB8, 0x2DBE, WORD},
+    {0x2DC0, 0x2DC6, WORD}, {0x2DC8, 0x2DCE, WORD}, {0x2DD0, 0x2DD6, WORD},
+    {0x2DD8, 0x2DDE, WORD}, {0x2DE0, 0x2DFF, WORD}, {0x2E00, 0x2E16, PUNCT},
+    {0x2E17, 0x2E17, DASH}, {0x2E18, 0x2E19, PUNCT}, {0x2E1A, 0x2E1A, DASH},
+    {0x2E1B, 0x2E2E, PUNCT}, {0x2E2F, 0x2E2F, WORD}, {0x2E30, 0x2E39, PUNCT},
+    {0x2E3A, 0x2E3B, DASH}, {0x2E3C, 0x2E3F, PUNCT}, {0x2E40, 0x2E40, DASH},
+    {0x2E41, 0x2E4F, PUNCT}, {0x2E50, 0x2E51, SYMBOL}, {0x2E52, 0x2E5C, PUNCT},
+    {0x2E5D, 0x2E5D, DASH}, {0x2E80, 0x2E99, SYMBOL}, {0x2E9B, 0x2EF3, SYMBOL},
+    {0x2F00, 0x2FD5, SYMBOL}, {0x2FF0, 0x2FFB, SYMBOL}, {0x3000, 0x3000, SPACE},
+    {0x3001, 0x3003, PUNCT}, {0x3004, 0x3004, SYMBOL}, {0x3005, 0x3007, WORD},
+    {0x3008, 0x3011, PUNCT}, {0x3012, 0x3013, SYMBOL}, {0x3014, 0x301B, PUNCT},
+    {0x301C, 0x301C, DASH}, {0x301D, 0x301F, PUNCT}, {0x3020, 0x3020, SYMBOL},
+    {0x3021, 0x302F, WORD}, {0x3030, 0x3030, DASH}, {0x3031, 0x3035, WORD},
+    {0x3036, 0x3037, SYMBOL}, {0x3038, 0x303C, WORD}, {0x303D, 0x303D, PUNCT},
+    {0x303E, 0x303F, SYMBOL}, {0x3041, 0x3096, WORD}, {0x3099, 0x309A, WORD},
+    {0x309B, 0x309C, SYMBOL}, {0x309D, 0x309F, WORD}, {0x30A0, 0x30A0, DASH},
+    {0x30A1, 0x30FA, WORD}, {0x30FB, 0x30FB, PUNCT}, {0x30FC, 0x30FF, WORD},
+    {0x3105, 0x312F, WORD}, {0x3131, 0x318E, WORD}, {0x3190, 0x3191, SYMBOL},
+    {0x3196, 0x319F, SYMBOL}, {0x31A0, 0x31BF, WORD}, {0x31C0, 0x31E3, SYMBOL},
+    {0x31F0, 0x31FF, WORD}, {0x3200, 0x321E, SYMBOL}, {0x322A, 0x3247, SYMBOL},
+    {0x3250, 0x3250, SYMBOL}, {0x3260, 0x327F, SYMBOL}, {0x328A, 0x32B0, SYMBOL},
+    {0x32C0, 0x33FF, SYMBOL}, {0x3400, 0x4DBF, WORD}, {0x4DC0, 0x4DFF, SYMBOL},
+    {0x4E00, 0xA48C, WORD}, {0xA490, 0xA4C6, SYMBOL}, {0xA4D0, 0xA4FD, WORD},
+    {0xA4FE, 0xA4FF, PUNCT}, {0xA500, 0xA60C, WORD}, {0xA60D, 0xA60F, PUNCT},
+    {0xA610, 0xA61F, WORD}, {0xA620, 0xA629, DIGIT}, {0xA62A, 0xA62B, WORD},
+    {0xA640, 0xA672, WORD}, {0xA673, 0xA673, PUNCT}, {0xA674, 0xA67D, WORD},
+    {0xA67E, 0xA67E, PUNCT}, {0xA67F, 0xA6F1, WORD}, {0xA6F2, 0xA6F7, PUNCT},
+    {0xA700, 0xA716, SYMBOL}, {0xA717, 0xA71F, WORD}, {0xA720, 0xA721, SYMBOL},
+    {0xA722, 0xA788, WORD}, {0xA789, 0xA78A, SYMBOL}, {0xA78B, 0xA7CA, WORD},
+    {0xA7D0, 0xA7D1, WORD}, {0xA7D3, 0xA7D3, WORD}, {0xA7D5, 0xA7D9, WORD},
+    {0xA7F2, 0xA827, WORD}, {0xA828, 0xA82B, SYMBOL}, {0xA82C, 0xA82C, WORD},
+    {0xA836, 0xA839, SYMBOL}, {0xA840, 0xA873, WORD}, {0xA874, 0xA877, PUNCT},
+    {0xA880, 0xA8C5, WORD}, {0xA8CE, 0xA8CF, PUNCT}, {0xA8D0, 0xA8D9, DIGIT},
+    {0xA8E0, 0xA8F7, WORD}, {0xA8F8, 0xA8FA, PUNCT}, {0xA8FB, 0xA8FB, WORD},
+    {0xA8FC, 0xA8FC, PUNCT}, {0xA8FD, 0xA8FF, WORD}, {0xA900, 0xA909, DIGIT},
+    {0xA90A, 0xA92D, WORD}, {0xA92E, 0xA92F, PUNCT}, {0xA930, 0xA953, WORD},
+    {0xA95F, 0xA95F, PUNCT}, {0xA960, 0xA97C, WORD}, {0xA980, 0xA9C0, WORD},
+    {0xA9C1, 0xA9CD, PUNCT}, {0xA9CF, 0xA9CF, WORD}, {0xA9D0, 0xA9D9, DIGIT},
+    {0xA9DE, 0xA9DF, PUNCT}, {0xA9E0, 0xA9EF, WORD}, {0xA9F0, 0xA9F9, DIGIT},
+    {0xA9FA, 0xA9FE, WORD}, {0xAA00, 0xAA36, WORD}, {0xAA40, 0xAA4D, WORD},
+    {0xAA50, 0xAA59, DIGIT}, {0xAA5C, 0xAA5F, PUNCT}, {0xAA60, 0xAA76, WORD},
+    {0xAA77, 0xAA79, SYMBOL}, {0xAA7A, 0xAAC2, WORD}, {0xAADB, 0xAADD, WORD},
+    {0xAADE, 0xAADF, PUNCT}, {0xAAE0, 0xAAEF, WORD}, {0xAAF0, 0xAAF1, PUNCT},
+    {0xAAF2, 0xAAF6, WORD}, {0xAB01, 0xAB06, WORD}, {0xAB09, 0xAB0E, WORD},
+    {0xAB11, 0xAB16, WORD}, {0xAB20, 0xAB26, WORD}, {0xAB28, 0xAB2E, WORD},
+    {0xAB30, 0xAB5A, WORD}, {0xAB5B, 0xAB5B, SYMBOL}, {0xAB5C, 0xAB69, WORD},
+    {0xAB6A, 0xAB6B, SYMBOL}, {0xAB70, 0xABEA, WORD}, {0xABEB, 0xABEB, PUNCT},
+    {0xABEC, 0xABED, WORD}, {0xABF0, 0xABF9, DIGIT}, {0xAC00, 0xD7A3, WORD},
+    {0xD7B0, 0xD7C6, WORD}, {0xD7CB, 0xD7FB, WORD}, {0xF900, 0xFA6D, WORD},
+    {0xFA70, 0xFAD9, WORD}, {0xFB00, 0xFB06, WORD}, {0xFB13, 0xFB17, WORD},
+    {0xFB1D, 0xFB28, WORD}, {0xFB29, 0xFB29, SYMBOL}, {0xFB2A, 0xFB36, WORD},
+    {0xFB38, 0xFB3C, WORD}, {0xFB3E, 0xFB3E, WORD}, {0xFB40, 0xFB41, WORD},
+    {0xFB43, 0xFB44, WORD}, {0xFB46, 0xFBB1, WORD}, {0xFBB2, 0xFBC2, SYMBOL},
+    {0xFBD3, 0xFD3D, WORD}, {0xFD3E, 0xFD3F, PUNCT}, {0xFD40, 0xFD4F, SYMBOL},
+    {0xFD50, 0xFD8F, WORD}, {0xFD92, 0xFDC7, WORD}, {0xFDCF, 0xFDCF, SYMBOL},
+    {0xFDF0, 0xFDFB, WORD}, {0xFDFC, 0xFDFF, SYMBOL}, {0xFE00, 0xFE0F, WORD},
+    {0xFE10, 0xFE19, PUNCT}, {0xFE20, 0xFE2F, WORD}, {0xFE30, 0xFE30, PUNCT},
+    {0xFE31, 0xFE32, DASH}, {0xFE33, 0xFE34, CONNECTOR}, {0xFE35, 0xFE4C, PUNCT},
+    {0xFE4D, 0xFE4F, CONNECTOR}, {0xFE50, 0xFE52, PUNCT}, {0xFE54, 0xFE57, PUNCT},
+    {0xFE58, 0xFE58, DASH}, {0xFE59, 0xFE61, PUNCT}, {0xFE62, 0xFE62, SYMBOL},
+    {0xFE63, 0xFE63, DASH}, {0xFE64, 0xFE66, SYMBOL}, {0xFE68, 0xFE68, PUNCT},
+    {0xFE69, 0xFE69, SYMBOL}, {0xFE6A, 0xFE6B, PUNCT}, {0xFE70, 0xFE74, WORD},
+    {0xFE76, 0xFEFC, WORD}, {0xFF01, 0xFF03, PUNCT}, {0xFF04, 0xFF04, SYMBOL},
+    {0xFF05, 0xFF0A, PUNCT}, {0xFF0B, 0xFF0B, SYMBOL}, {0xFF0C, 0xFF0C, PUNCT},
+    {0xFF0D, 0xFF0D, DASH}, {0xFF0E, 0xFF0F, PUNCT}, {0xFF10, 0xFF19, DIGIT},
+    {0xFF1A, 0xFF1B, PUNCT}, {0xFF1C, 0xFF1E, SYMBOL}, {0xFF1F, 0xFF20, PUNCT},
+    {0xFF21, 0xFF3A, WORD}, {0xFF3B, 0xFF3D, PUNCT}, {0xFF3E, 0xFF3E, SYMBOL},
+    {0xFF3F, 0xFF3F, CONNECTOR}, {0xFF40, 0xFF40, SYMBOL}, {0xFF41, 0xFF5A, WORD},
+    {0xFF5B, 0xFF5B, PUNCT}, {0xFF5C, 0xFF5C, SYMBOL}, {0xFF5D, 0xFF5D, PUNCT},
+    {0xFF5E, 0xFF5E, SYMBOL}, {0xFF5F, 0xFF65, PUNCT}, {0xFF66, 0xFFBE, WORD},
+    {0xFFC2, 0xFFC7, WORD}, {0xFFCA, 0xFFCF, WORD}, {0xFFD2, 0xFFD7, WORD},
+    {0xFFDA, 0xFFDC, WORD}, {0xFFE0, 0xFFE6, SYMBOL}, {0xFFE8, 0xFFEE, SYMBOL},
+    {0xFFFC, 0xFFFD, SYMBOL}, {0x10000, 0x1000B, WORD}, {0x1000D, 0x10026, WORD},
+    {0x10028, 0x1003A, WORD}, {0x1003C, 0x1003D, WORD}, {0x1003F, 0x1004D, WORD},
+    {0x10050, 0x1005D, WORD}, {0x10080, 0x100FA, WORD}, {0x10100, 0x10102, PUNCT},
+    {0x10137, 0x1013F, SYMBOL}, {0x10140, 0x10174, WORD}, {0x10179, 0x10189, SYMBOL},
+    {0x1018C, 0x1018E, SYMBOL}, {0x10190, 0x1019C, SYMBOL}, {0x101A0, 0x101A0, SYMBOL},
+    {0x101D0, 0x101FC, SYMBOL}, {0x101FD, 0x101FD, WORD}, {0x10280, 0x1029C, WORD},
+    {0x102A0, 0x102D0, WORD}, {0x102E0, 0x102E0, WORD}, {0x10300, 0x1031F, WORD},
+    {0x1032D, 0x1034A, WORD}, {0x10350, 0x1037A, WORD}, {0x10380, 0x1039D, WORD},
+    {0x1039F, 0x1039F, PUNCT}, {0x103A0, 0x103C3, WORD}, {0x103C8, 0x103CF, WORD},
+    {0x103D0, 0x103D0, PUNCT}, {0x103D1, 0x103D5, WORD}, {0x10400, 0x1049D, WORD},
+    {0x104A0, 0x104A9, DIGIT}, {0x104B0, 0x104D3, WORD}, {0x104D8, 0x104FB, WORD},
+    {0x10500, 0x10527, WORD}, {0x10530, 0x10563, WORD}, {0x1056F, 0x1056F, PUNCT},
+    {0x10570, 0x1057A, WORD}, {0x1057C, 0x1058A, WORD}, {0x1058C, 0x10592, WORD},
+    {0x10594, 0x10595, WORD}, {0x10597, 0x105A1, WORD}, {0x105A3, 0x105B1, WORD},
+    {0x105B3, 0x105B9, WORD}, {0x105BB, 0x105BC, WORD}, {0x10600, 0x10736, WORD},
+    {0x10740, 0x10755, WORD}, {0x10760, 0x10767, WORD}, {0x10780, 0x10785, WORD},
+    {0x10787, 0x107B0, WORD}, {0x107B2, 0x107BA, WORD}, {0x10800, 0x10805, WORD},
+    {0x10808, 0x10808, WORD}, {0x1080A, 0x10835, WORD}, {0x10837, 0x10838, WORD},
+    {0x1083C, 0x1083C, WORD}, {0x1083F, 0x10855, WORD}, {0x10857, 0x10857, PUNCT},
+    {0x10860, 0x10876, WORD}, {0x10877, 0x10878, SYMBOL}, {0x10880, 0x1089E, WORD},
+    {0x108E0, 0x108F2, WORD}, {0x108F4, 0x108F5, WORD}, {0x10900, 0x10915, WORD},
+    {0x1091F, 0x1091F, PUNCT}, {0x10920, 0x10939, WORD}, {0x1093F, 0x1093F, PUNCT},
+    {0x10980, 0x109B7, WORD}, {0x109BE, 0x109BF, WORD}, {0x10A00, 0x10A03, WORD},
+    {0x10A05, 0x10A06, WORD}, {0x10A0C, 0x10A13, WORD}, {0x10A15, 0x10A17, WORD},
+    {0x10A19, 0x10A35, WORD}, {0x10A38, 0x10A3A, WORD}, {0x10A3F, 0x10A3F, WORD},
+    {0x10A50, 0x10A58, PUNCT}, {0x10A60, 0x10A7C, WORD}, {0x10A7F, 0x10A7F, PUNCT},
+    {0x10A80, 0x10A9C, WORD}, {0x10AC0, 0x10AC7, WORD}, {0x10AC8, 0x10AC8, SYMBOL},
+    {0x10AC9, 0x10AE6, WORD}, {0x10AF0, 0x10AF6, PUNCT}, {0x10B00, 0x10B35, WORD},
+    {0x10B39, 0x10B3F, PUNCT}, {0x10B40, 0x10B55, WORD}, {0x10B60, 0x10B72, WORD},
+    {0x10B80, 0x10B91, WORD}, {0x10B99, 0x10B9C, PUNCT}, {0x10C00, 0x10C48, WORD},
+    {0x10C80, 0x10CB2, WORD}, {0x10CC0, 0x10CF2, WORD}, {0x10D00, 0x10D27, WORD},
+    {0x10D30, 0x10D39, DIGIT}, {0x10E80, 0x10EA9, WORD}, {0x10EAB, 0x10EAC, WORD},
+    {0x10EAD, 0x10EAD, DASH}, {0x10EB0, 0x10EB1, WORD}, {0x10F00, 0x10F1C, WORD},
+    {0x10F27, 0x10F27, WORD}, {0x10F30, 0x10F50, WORD}, {0x10F55, 0x10F59, PUNCT},
+    {0x10F70, 0x10F85, WORD}, {0x10F86, 0x10F89, PUNCT}, {0x10FB0, 0x10FC4, WORD},
+    {0x10FE0, 0x10FF6, WORD}, {0x11000, 0x11046, WORD}, {0x11047, 0x1104D, PUNCT},
+    {0x11066, 0x1106F, DIGIT}, {0x11070, 0x11075, WORD}, {0x1107F, 0x110BA, WORD},
+    {0x110BB, 0x110BC, PUNCT}, {0x110BE, 0x110C1, PUNCT}, {0x110C2, 0x110C2, WORD},
+    {0x110D0, 0x110E8, WORD}, {0x110F0, 0x110F9, DIGIT}, {0x11100, 0x11134, WORD},
+    {0x11136, 0x1113F, DIGIT}, {0x11140, 0x11143, PUNCT}, {0x11144, 0x11147, WORD},
+    {0x11150, 0x11173, WORD}, {0x11174, 0x11175, PUNCT}, {0x11176, 0x11176, WORD},
+    {0x11180, 0x111C4, WORD}, {0x111C5, 0x111C8, PUNCT}, {0x111C9, 0x111CC, WORD},
+    {0x111CD, 0x111CD, PUNCT}, {0x111CE, 0x111CF, WORD}, {0x111D0, 0x111D9, DIGIT},
+    {0x111DA, 0x111DA, WORD}, {0x111DB, 0x111DB, PUNCT}, {0x111DC, 0x111DC, WORD},
+    {0x111DD, 0x111DF, PUNCT}, {0x11200, 0x11211, WORD}, {0x11213, 0x11237, WORD},
+    {0x11238, 0x1123D, PUNCT}, {0x1123E, 0x1123E, WORD}, {0x11280, 0x11286, WORD},
+    {0x11288, 0x11288, WORD}, {0x1128A, 0x1128D, WORD}, {0x1128F, 0x1129D, WORD},
+    {0x1129F, 0x112A8, WORD}, {0x112A9, 0x112A9, PUNCT}, {0x112B0, 0x112EA, WORD},
+    {0x112F0, 0x112F9, DIGIT}, {0x11300, 0x11303, WORD}, {0x11305, 0x1130C, WORD},
+    {0x1130F, 0x11310, WORD}, {0x11313, 0x11328, WORD}, {0x1132A, 0x11330, WORD},
+    {0x11332, 0x11333, WORD}, {0x11335, 0x11339, WORD}, {0x1133B, 0x11344, WORD},
+    {0x11347, 0x11348, WORD}, {0x1134B, 0x1134D, WORD}, {0x11350, 0x11350, WORD},
+    {0x11357, 0x11357, WORD}, {0x1135D, 0x11363, WORD}, {0x11366, 0x1136C, WORD},
+    {0x11370, 0x11374, WORD}, {0x11400, 0x1144A, WORD}, {0x1144B, 0x1144F, PUNCT},
+    {0x11450, 0x11459, DIGIT}, {0x1145A, 0x1145B, PUNCT}, {0x1145D, 0x1145D, PUNCT},
+    {0x1145E, 0x11461, WORD}, {0x11480, 0x114C5, WORD}, {0x114C6, 0x114C6, PUNCT},
+    {0x114C7, 0x114C7, WORD}, {0x114D0, 0x114D9, DIGIT}, {0x11580, 0x115B5, WORD},
+    {0x115B8, 0x115C0, WORD}, {0x115C1, 0x115D7, PUNCT}, {0x115D8, 0x115DD, WORD},
+    {0x11600, 0x11640, WORD}, {0x11641, 0x11643, PUNCT}, {0x11644, 0x11644, WORD},
+    {0x11650, 0x11659, DIGIT}, {0x11660, 0x1166C, PUNCT}, {0x11680, 0x116B8, WORD},
+    {0x116B9, 0x116B9, PUNCT}, {0x116C0, 0x116C9, DIGIT}, {0x11700, 0x1171A, WORD},
+    {0x1171D, 0x1172B, WORD}, {0x11730, 0x11739, DIGIT}, {0x1173C, 0x1173E, PUNCT},
+    {0x1173F, 0x1173F, SYMBOL}, {0x11740, 0x11746, WORD}, {0x11800, 0x1183A, WORD},
+    {0x1183B, 0x1183B, PUNCT}, {0x118A0, 0x118DF, WORD}, {0x118E0, 0x118E9, DIGIT},
+    {0x118FF, 0x11906, WORD}, {0x11909, 0x11909, WORD}, {0x1190C, 0x11913, WORD},
+    {0x11915, 0x11916, WORD}, {0x11918, 0x11935, WORD}, {0x11937, 0x11938, WORD},
+    {0x1193B, 0x11943, WORD}, {0x11944, 0x11946, PUNCT}, {0x11950, 0x11959, DIGIT},
+    {0x119A0, 0x119A7, WORD}, {0x119AA, 0x119D7, WORD}, {0x119DA, 0x119E1, WORD},
+    {0x119E2, 0x119E2, PUNCT}, {0x119E3, 0x119E4, WORD}, {0x11A00, 0x11A3E, WORD},
+    {0x11A3F, 0x11A46, PUNCT}, {0x11A47, 0x11A47, WORD}, {0x11A50, 0x11A99, WORD},
+    {0x11A9A, 0x11A9C, PUNCT}, {0x11A9D, 0x11A9D, WORD}, {0x11A9E, 0x11AA2, PUNCT},
+    {0x11AB0, 0x11AF8, WORD}, {0x11C00, 0x11C08, WORD}, {0x11C0A, 0x11C36, WORD},
+    {0x11C38, 0x11C40, WORD}, {0x11C41, 0x11C45, PUNCT}, {0x11C50, 0x11C59, DIGIT},
+    {0x11C70, 0x11C71, PUNCT}, {0x11C72, 0x11C8F, WORD}, {0x11C92, 0x11CA7, WORD},
+    {0x11CA9, 0x11CB6, WORD}, {0x11D00, 0x11D06, WORD}, {0x11D08, 0x11D09, WORD},
+    {0x11D0B, 0x11D36, WORD}, {0x11D3A, 0x11D3A, WORD}, {0x11D3C, 0x11D3D, WORD},
+    {0x11D3F, 0x11D47, WORD}, {0x11D50, 0x11D59, DIGIT}, {0x11D60, 0x11D65, WORD},
+    {0x11D67, 0x11D68, WORD}, {0x11D6A, 0x11D8E, WORD}, {0x11D90, 0x11D91, WORD},
+    {0x11D93, 0x11D98, WORD}, {0x11DA0, 0x11DA9, DIGIT}, {0x11EE0, 0x11EF6, WORD},
+    {0x11EF7, 0x11EF8, PUNCT}, {0x11FB0, 0x11FB0, WORD}, {0x11FD5, 0x11FF1, SYMBOL},
+    {0x11FFF, 0x11FFF, PUNCT}, {0x12000, 0x12399, WORD}, {0x12400, 0x1246E, WORD},
+    {0x12470, 0x12474, PUNCT}, {0x12480, 0x12543, WORD}, {0x12F90, 0x12FF0, WORD},
+    {0x12FF1, 0x12FF2, PUNCT}, {0x13000, 0x1342E, WORD}, {0x14400, 0x14646, WORD},
+    {0x16800, 0x16A38, WORD}, {0x16A40, 0x16A5E, WORD}, {0x16A60, 0x16A69, DIGIT},
+    {0x16A6E, 0x16A6F, PUNCT}, {0x16A70, 0x16ABE, WORD}, {0x16AC0, 0x16AC9, DIGIT},
+    {0x16AD0, 0x16AED, WORD}, {0x16AF0, 0x16AF4, WORD}, {0x16AF5, 0x16AF5, PUNCT},
+    {0x16B00, 0x16B36, WORD}, {0x16B37, 0x16B3B, PUNCT}, {0x16B3C, 0x16B3F, SYMBOL},
+    {0x16B40, 0x16B43, WORD}, {0x16B44, 0x16B44, PUNCT}, {0x16B45, 0x16B45, SYMBOL},
+    {0x16B50, 0x16B59, DIGIT}, {0x16B63, 0x16B77, WORD}, {0x16B7D, 0x16B8F, WORD},
+    {0x16E40, 0x16E7F, WORD}, {0x16E97, 0x16E9A, PUNCT}, {0x16F00, 0x16F4A, WORD},
+    {0x16F4F, 0x16F87, WORD}, {0x16F8F, 0x16F9F, WORD}, {0x16FE0, 0x16FE1, WORD},
+    {0x16FE2, 0x16FE2, PUNCT}, {0x16FE3, 0x16FE4, WORD}, {0x16FF0, 0x16FF1, WORD},
+    {0x17000, 0x187F7, WORD}, {0x18800, 0x18CD5, WORD}, {0x18D00, 0x18D08, WORD},
+    {0x1AFF0, 0x1AFF3, WORD}, {0x1AFF5, 0x1AFFB, WORD}, {0x1AFFD, 0x1AFFE, WORD},
+    {0x1B000, 0x1B122, WORD}, {0x1B150, 0x1B152, WORD}, {0x1B164, 0x1B167, WORD},
+    {0x1B170, 0x1B2FB, WORD}, {0x1BC00, 0x1BC6A, WORD}, {0x1BC70, 0x1BC7C, WORD},
+    {0x1BC80, 0x1BC88, WORD}, {0x1BC90, 0x1BC99, WORD}, {0x1BC9C, 0x1BC9C, SYMBOL},
+    {0x1BC9D, 0x1BC9E, WORD}, {0x1BC9F, 0x1BC9F, PUNCT}, {0x1CF00, 0x1CF2D, WORD},
+    {0x1CF30, 0x1CF46, WORD}, {0x1CF50, 0x1CFC3, SYMBOL}, {0x1D000, 0x1D0F5, SYMBOL},
+    {0x1D100, 0x1D126, SYMBOL}, {0x1D129, 0x1D164, SYMBOL}, {0x1D165, 0x1D169, WORD},
+    {0x1D16A, 0x1D16C, SYMBOL}, {0x1D16D, 0x1D172, WORD}, {0x1D17B, 0x1D182, WORD},
+    {0x1D183, 0x1D184, SYMBOL}, {0x1D185, 0x1D18B, WORD}, {0x1D18C, 0x1D1A9, SYMBOL},
+    {0x1D1AA, 0x1D1AD, WORD}, {0x1D1AE, 0x1D1EA, SYMBOL}, {0x1D200, 0x1D241, SYMBOL},
+    {0x1D242, 0x1D244, WORD}, {0x1D245, 0x1D245, SYMBOL}, {0x1D300, 0x1D356, SYMBOL},
+    {0x1D400, 0x1D454, WORD}, {0x1D456, 0x1D49C, WORD}, {0x1D49E, 0x1D49F, WORD},
+    {0x1D4A2, 0x1D4A2, WORD}, {0x1D4A5, 0x1D4A6, WORD}, {0x1D4A9, 0x1D4AC, WORD},
+    {0x1D4AE, 0x1D4B9, WORD}, {0x1D4BB, 0x1D4BB, WORD}, {0x1D4BD, 0x1D4C3, WORD},
+    {0x1D4C5, 0x1D505, WORD}, {0x1D507, 0x1D50A, WORD}, {0x1D50D, 0x1D514, WORD},
+    {0x1D516, 0x1D51C, WORD}, {0x1D51E, 0x1D539, WORD}, {0x1D53B, 0x1D53E, WORD},
+    {0x1D540, 0x1D544, WORD}, {0x1D546, 0x1D546, WORD}, {0x1D54A, 0x1D550, WORD},
+    {0x1D552, 0x1D6A5, WORD}, {0x1D6A8, 0x1D6C0, WORD}, {0x1D6C1, 0x1D6C1, SYMBOL},
+    {0x1D6C2, 0x1D6DA, WORD}, {0x1D6DB, 0x1D6DB, SYMBOL}, {0x1D6DC, 0x1D6FA, WORD},
+    {0x1D6FB, 0x1D6FB, SYMBOL}, {0x1D6FC, 0x1D714, WORD}, {0x1D715, 0x1D715, SYMBOL},
+    {0x1D716, 0x1D734, WORD}, {0x1D735, 0x1D735, SYMBOL}, {0x1D736, 0x1D74E, WORD},
+    {0x1D74F, 0x1D74F, SYMBOL}, {0x1D750, 0x1D76E, WORD}, {0x1D76F, 0x1D76F, SYMBOL},
+    {0x1D770, 0x1D788, WORD}, {0x1D789, 0x1D789, SYMBOL}, {0x1D78A, 0x1D7A8, WORD},
+    {0x1D7A9, 0x1D7A9, SYMBOL}, {0x1D7AA, 0x1D7C2, WORD}, {0x1D7C3, 0x1D7C3, SYMBOL},
+    {0x1D7C4, 0x1D7CB, WORD}, {0x1D7CE, 0x1D7FF, DIGIT}, {0x1D800, 0x1D9FF, SYMBOL},
+    {0x1DA00, 0x1DA36, WORD}, {0x1DA37, 0x1DA3A, SYMBOL}, {0x1DA3B, 0x1DA6C, WORD},
+    {0x1DA6D, 0x1DA74, SYMBOL}, {0x1DA75, 0x1DA75, WORD}, {0x1DA76, 0x1DA83, SYMBOL},
+    {0x1DA84, 0x1DA84, WORD}, {0x1DA85, 0x1DA86, SYMBOL}, {0x1DA87, 0x1DA8B, PUNCT},
+    {0x1DA9B, 0x1DA9F, WORD}, {0x1DAA1, 0x1DAAF, WORD}, {0x1DF00, 0x1DF1E, WORD},
+    {0x1E000, 0x1E006, WORD}, {0x1E008, 0x1E018, WORD}, {0x1E01B, 0x1E021, WORD},
+    {0x1E023, 0x1E024, WORD}, {0x1E026, 0x1E02A, WORD}, {0x1E100, 0x1E12C, WORD},
+    {0x1E130, 0x1E13D, WORD}, {0x1E140, 0x1E149, DIGIT}, {0x1E14E, 0x1E14E, WORD},
+    {0x1E14F, 0x1E14F, SYMBOL}, {0x1E290, 0x1E2AE, WORD}, {0x1E2C0, 0x1E2EF, WORD},
+    {0x1E2F0, 0x1E2F9, DIGIT}, {0x1E2FF, 0x1E2FF, SYMBOL}, {0x1E7E0, 0x1E7E6, WORD},
+    {0x1E7E8, 0x1E7EB, WORD}, {0x1E7ED, 0x1E7EE, WORD}, {0x1E7F0, 0x1E7FE, WORD},
+    {0x1E800, 0x1E8C4, WORD}, {0x1E8D0, 0x1E8D6, WORD}, {0x1E900, 0x1E94B, WORD},
+    {0x1E950, 0x1E959, DIGIT}, {0x1E95E, 0x1E95F, PUNCT}, {0x1ECAC, 0x1ECAC, SYMBOL},
+    {0x1ECB0, 0x1ECB0, SYMBOL}, {0x1ED2E, 0x1ED2E, SYMBOL}, {0x1EE00, 0x1EE03, WORD},
+    {0x1EE05, 0x1EE1F, WORD}, {0x1EE21, 0x1EE22, WORD}, {0x1EE24, 0x1EE24, WORD},
+    {0x1EE27, 0x1EE27, WORD}, {0x1EE29, 0x1EE32, WORD}, {0x1EE34, 0x1EE37, WORD},
+    {0x1EE39, 0x1EE39, WORD}, {0x1EE3B, 0x1EE3B, WORD}, {0x1EE42, 0x1EE42, WORD},
+    {0x1EE47, 0x1EE47, WORD}, {0x1EE49, 0x1EE49, WORD}, {0x1EE4B, 0x1EE4B, WORD},
+    {0x1EE4D, 0x1EE4F, WORD}, {0x1EE51, 0x1EE52, WORD}, {0x1EE54, 0x1EE54, WORD},
+    {0x1EE57, 0x1EE57, WORD}, {0x1EE59, 0x1EE59, WORD}, {0x1EE5B, 0x1EE5B, WORD},
+    {0x1EE5D, 0x1EE5D, WORD}, {0x1EE5F, 0x1EE5F, WORD}, {0x1EE61, 0x1EE62, WORD},
+    {0x1EE64, 0x1EE64, WORD}, {0x1EE67, 0x1EE6A, WORD}, {0x1EE6C, 0x1EE72, WORD},
+    {0x1EE74, 0x1EE77, WORD}, {0x1EE79, 0x1EE7C, WORD}, {0x1EE7E, 0x1EE7E, WORD},
+    {0x1EE80, 0x1EE89, WORD}, {0x1EE8B, 0x1EE9B, WORD}, {0x1EEA1, 0x1EEA3, WORD},
+    {0x1EEA5, 0x1EEA9, WORD}, {0x1EEAB, 0x1EEBB, WORD}, {0x1EEF0, 0x1EEF1, SYMBOL},
+    {0x1F000, 0x1F02B, SYMBOL}, {0x1F030, 0x1F093, SYMBOL}, {0x1F0A0, 0x1F0AE, SYMBOL},
+    {0x1F0B1, 0x1F0BF, SYMBOL}, {0x1F0C1, 0x1F0CF, SYMBOL}, {0x1F0D1, 0x1F0F5, SYMBOL},
+    {0x1F10D, 0x1F1AD, SYMBOL}, {0x1F1E6, 0x1F202, SYMBOL}, {0x1F210, 0x1F23B, SYMBOL},
+    {0x1F240, 0x1F248, SYMBOL}, {0x1F250, 0x1F251, SYMBOL}, {0x1F260, 0x1F265, SYMBOL},
+    {0x1F300, 0x1F6D7, SYMBOL}, {0x1F6DD, 0x1F6EC, SYMBOL}, {0x1F6F0, 0x1F6FC, SYMBOL},
+    {0x1F700, 0x1F773, SYMBOL}, {0x1F780, 0x1F7D8, SYMBOL}, {0x1F7E0, 0x1F7EB, SYMBOL},
+    {0x1F7F0, 0x1F7F0, SYMBOL}, {0x1F800, 0x1F80B, SYMBOL}, {0x1F810, 0x1F847, SYMBOL},
+    {0x1F850, 0x1F859, SYMBOL}, {0x1F860, 0x1F887, SYMBOL}, {0x1F890, 0x1F8AD, SYMBOL},
+    {0x1F8B0, 0x1F8B1, SYMBOL}, {0x1F900, 0x1FA53, SYMBOL}, {0x1FA60, 0x1FA6D, SYMBOL},
+    {0x1FA70, 0x1FA74, SYMBOL}, {0x1FA78, 0x1FA7C, SYMBOL}, {0x1FA80, 0x1FA86, SYMBOL},
+    {0x1FA90, 0x1FAAC, SYMBOL}, {0x1FAB0, 0x1FABA, SYMBOL}, {0x1FAC0, 0x1FAC5, SYMBOL},
+    {0x1FAD0, 0x1FAD9, SYMBOL}, {0x1FAE0, 0x1FAE7, SYMBOL}, {0x1FAF0, 0x1FAF6, SYMBOL},
+    {0x1FB00, 0x1FB92, SYMBOL}, {0x1FB94, 0x1FBCA, SYMBOL}, {0x1FBF0, 0x1FBF9, DIGIT},
+    {0x20000, 0x2A6DF, WORD}, {0x2A700, 0x2B738, WORD}, {0x2B740, 0x2B81D, WORD},
+    {0x2B820, 0x2CEA1, WORD}, {0x2CEB0, 0x2EBE0, WORD}, {0x2F800, 0x2FA1D, WORD},
+    {0x30000, 0x3134A, WORD}, {0xE0100, 0xE01EF, WORD},
+};
+
+inline CharClass char_class(const uint32_t c) {
+    if (c < 128) return ascii_classes[c];
+    const CharRange *end = ranges + sizeof(ranges) / sizeof(CharRange);
+    const CharRange *it = std::upper_bound(ranges, end, c, [](const uint32_t x, const CharRange &r) {
+        return x < r.first;
+    });
+    if (it == ranges || c > (it - 1)->last) return OTHER;
+    return (it - 1)->type;
+}
+
+// Characters that are \w in ICU regular expressions
+inline bool is_word(const CharClass type) {
+    return type == WORD || type == DIGIT || type == CONNECTOR;
+}
+
+} // namespace unicode
+
+#endif
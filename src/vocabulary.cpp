@@ -0,0 +1,198 @@
+#include "quanteda.h"
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+bool match_glob(const std::string &pattern, const std::string &str); // defined in dictionary.cpp
+
+// Types sorted as they are and with their bytes reversed, so that the types
+// with a given prefix or suffix are a range of the sorted types
+class TypeTable {
+public:
+    std::vector<std::string> types;
+    std::vector<std::string> reversed;
+    std::vector<int> sorted, sorted_reversed;
+    std::unordered_map<std::string, std::vector<int> > map_types;
+
+    explicit TypeTable(const std::vector<std::string> &types_) : types(types_) {
+        std::size_t n = types.size();
+        reversed.resize(n);
+        sorted.resize(n);
+        for (std::size_t g = 0; g < n; g++) {
+            reversed[g].assign(types[g].rbegin(), types[g].rend());
+            sorted[g] = g;
+            map_types[types[g]].push_back(g + 1);
+        }
+        sorted_reversed = sorted;
+        std::sort(sorted.begin(), sorted.end(),
+                  [this](int a, int b) { return types[a] < types[b]; });
+        std::sort(sorted_reversed.begin(), sorted_reversed.end(),
+                  [this](int a, int b) { return reversed[a] < reversed[b]; });
+    }
+
+    // Indices of the types starting with prefix in the sorted strings
+    static std::pair<std::size_t, std::size_t> range(const std::vector<std::string> &strings,
+                                                     const std::vector<int> &order,
+                                                     const std::string &prefix) {
+        auto lower = std::lower_bound(order.begin(), order.end(), prefix,
+                                      [&strings](int a, const std::string &b) { return strings[a] < b; });
+        auto upper = lower;
+        while (upper != order.end() && strings[*upper].compare(0, prefix.size(), prefix) == 0) ++upper;
+        return std::make_pair(lower - order.begin(), upper - order.begin());
+    }
+
+    // IDs of the types matched by a fixed value or a glob pattern, in order.
+    // Globs with a literal prefix or suffix are matched against the range of
+    // types that have the longer of them, and others against all the types.
+    std::vector<int> match(const std::string &pattern, const bool glob) const {
+        std::vector<int> ids;
+        std::size_t first = glob ? pattern.find_first_of("*?") : std::string::npos;
+        if (first == std::string::npos) {
+            auto it = map_types.find(pattern);
+            if (it != map_types.end()) ids = it->second;
+            return ids;
+        }
+        std::size_t last = pattern.find_last_of("*?");
+        std::string prefix = pattern.substr(0, first);
+        std::string suffix(pattern.rbegin(), pattern.rbegin() + (pattern.size() - last - 1));
+        bool exact = pattern.find_first_not_of('*', first) > last; // only stars in between
+        if (!prefix.empty() && prefix.size() >= suffix.size()) {
+            std::pair<std::size_t, std::size_t> r = range(types, sorted, prefix);
+            for (std::size_t k = r.first; k < r.second; k++) {
+                int g = sorted[k];
+                if ((exact && suffix.empty()) || match_glob(pattern, types[g])) ids.push_back(g + 1);
+            }
+        } else if (!suffix.empty()) {
+            std::pair<std::size_t, std::size_t> r = range(reversed, sorted_reversed, suffix);
+            for (std::size_t k = r.first; k < r.second; k++) {
+                int g = sorted_reversed[k];
+                if ((exact && prefix.empty()) || match_glob(pattern, types[g])) ids.push_back(g + 1);
+            }
+        } else {
+            for (std::size_t g = 0; g < types.size(); g++) {
+                if (match_glob(pattern, types[g])) ids.push_back(g + 1);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+};
+
+// Index of the types of tokens or the features of a dfm, as they are and
+// case-folded
+class VocabularyIndex {
+public:
+    TypeTable exact, folded;
+    VocabularyIndex(const std::vector<std::string> &types,
+                    const std::vector<std::string> &types_folded) :
+        exact(types), folded(types_folded) {}
+};
+
+// [[Rcpp::export]]
+SEXP vocabulary_index_cpp(const std::vector<std::string> &types,
+                          const std::vector<std::string> &types_folded){
+    if (types.size() != types_folded.size()) stop("Invalid case-folded types");
+    XPtr<VocabularyIndex> index(new VocabularyIndex(types, types_folded), true);
+    return index;
+}
+
+// Position (1-based) of the object in a list by address, or 0, so that an
+// object is found among cached ones without comparing its contents
+// [[Rcpp::export]]
+int vocabulary_find_cpp(SEXP objects, SEXP x){
+    if (Rf_isNull(objects)) return 0;
+    if (TYPEOF(objects) != VECSXP) stop("Invalid list of objects");
+    for (int k = 0; k < LENGTH(objects); k++) {
+        if (VECTOR_ELT(objects, k) == x) return k + 1;
+    }
+    return 0;
+}
+
+// Match fixed values or glob patterns against an index, returning the IDs of
+// the types matched by each pattern. Patterns are matched in parallel.
+// Patterns must be case-folded by the caller when case_insensitive.
+// [[Rcpp::export]]
+List vocabulary_match_cppl(SEXP index_,
+                           const std::vector<std::string> &patterns,
+                           const bool glob,
+                           const bool case_insensitive,
+                           const int thread){
+
+    XPtr<VocabularyIndex> index(index_);
+    if (index.get() == NULL) stop("Invalid vocabulary index");
+    const TypeTable &table = case_insensitive ? index->folded : index->exact;
+
+    int n_patterns = patterns.size();
+    std::vector< std::vector<int> > ids_patterns(n_patterns);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 1)
+    #endif
+    for (int k = 0; k < n_patterns; k++) {
+        ids_patterns[k] = table.match(patterns[k], glob);
+    }
+
+    List result(n_patterns);
+    for (int k = 0; k < n_patterns; k++) {
+        result[k] = IntegerVector(ids_patterns[k].begin(), ids_patterns[k].end());
+    }
+    return result;
+}
+
+// Documents in which each type occurs, as the column pointers and row
+// indices of a types x documents pattern matrix, from hashed tokens. Types
+// are collected in parallel over documents.
+// [[Rcpp::export]]
+List vocabulary_postings_cppl(List texts, const int n_types, const int thread){
+
+    int n_docs = texts.size();
+    std::vector<const int*> ptrs(n_docs);
+    std::vector<std::size_t> lens(n_docs);
+    for (int h = 0; h < n_docs; h++) {
+        SEXP text = texts[h];
+        ptrs[h] = INTEGER(text);
+        lens[h] = LENGTH(text);
+        for (std::size_t i = 0; i < lens[h]; i++) {
+            if (ptrs[h][i] < 0 || ptrs[h][i] > n_types) stop("Invalid type ID in tokens");
+        }
+    }
+
+    // Unique types of each document
+    std::vector< std::vector<int> > types_docs(n_docs);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<char> seen(n_types + 1, false);
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+        #endif
+        for (int h = 0; h < n_docs; h++) {
+            std::vector<int> &types = types_docs[h];
+            for (std::size_t i = 0; i < lens[h]; i++) {
+                int id = ptrs[h][i];
+                if (id == 0 || seen[id]) continue;
+                seen[id] = true;
+                types.push_back(id);
+            }
+            for (std::size_t j = 0; j < types.size(); j++) seen[types[j]] = false;
+        }
+    }
+
+    // Documents of each type, in order of documents
+    std::vector<int> p(n_types + 1, 0);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < types_docs[h].size(); j++) p[types_docs[h][j]]++;
+    }
+    for (int g = 0; g < n_types; g++) p[g + 1] += p[g];
+    IntegerVector docs(p[n_types]);
+    std::vector<int> pos(p.begin(), p.end() - 1);
+    for (int h = 0; h < n_docs; h++) {
+        for (std::size_t j = 0; j < types_docs[h].size(); j++) docs[pos[types_docs[h][j] - 1]++] = h;
+        std::vector<int>().swap(types_docs[h]);
+    }
+    return List::create(_["p"] = IntegerVector(p.begin(), p.end()),
+                        _["i"] = docs);
+}
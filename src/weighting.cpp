@@ -0,0 +1,139 @@
+#include "quanteda.h"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace Rcpp;
+
+// Transformations of the counts applied before scaling
+enum Transform { NONE = 0, LOG = 1, BOOLEAN = 2 };
+
+// Weight the non-zero cells of a dfm given as the slots of a dgCMatrix, as
+//   shift + factor * f(x) / row_div[i] * col_mul[j]
+// where f is one of the transformations; row_div and col_mul are not applied
+// if empty. Columns are weighted in parallel. With inplace, slot_x is
+// overwritten and returned, so it must not be shared with another object;
+// otherwise a new vector of the same length is returned.
+// [[Rcpp::export]]
+NumericVector dfm_weight_cppl(NumericVector slot_x,
+                              const IntegerVector &slot_i,
+                              const IntegerVector &slot_p,
+                              const int transform,
+                              const double base,
+                              const std::vector<double> &row_div,
+                              const std::vector<double> &col_mul,
+                              const double factor,
+                              const double shift,
+                              const bool inplace,
+                              const int thread){
+
+    int n_cols = slot_p.size() - 1;
+    std::size_t n_cells = slot_x.size();
+    if (n_cols < 0 || (std::size_t)slot_i.size() != n_cells) stop("Invalid slots of a dfm");
+    if (!col_mul.empty() && (int)col_mul.size() != n_cols) stop("Invalid column weights");
+    if (transform < NONE || transform > BOOLEAN) stop("Invalid transformation");
+    const int *rows = INTEGER(slot_i);
+    const int *ptrs = INTEGER(slot_p);
+    if (ptrs[n_cols] != (int)n_cells) stop("Invalid slots of a dfm");
+    if (!row_div.empty()) {
+        for (std::size_t k = 0; k < n_cells; k++) {
+            if (rows[k] < 0 || rows[k] >= (int)row_div.size()) stop("Invalid row index of a dfm");
+        }
+    }
+
+    NumericVector result = inplace ? slot_x : NumericVector(n_cells);
+    const double *x = REAL(slot_x);
+    double *y = REAL(result);
+    const double log_base = std::log(base);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 256)
+    #endif
+    for (int j = 0; j < n_cols; j++) {
+        double mul = col_mul.empty() ? factor : factor * col_mul[j];
+        for (int k = ptrs[j]; k < ptrs[j + 1]; k++) {
+            double v = x[k];
+            if (transform == LOG) {
+                v = 1 + std::log(v) / log_base;
+                if (std::isinf(v)) v = 0; // explicit zeros
+            } else if (transform == BOOLEAN) {
+                v = v > 0;
+            }
+            if (!row_div.empty()) v /= row_div[rows[k]];
+            y[k] = shift + mul * v;
+        }
+    }
+    return result;
+}
+
+// Maximum count of each document. Columns are
+// scanned in parallel into the maxima of each thread, which are then merged.
+// [[Rcpp::export]]
+NumericVector dfm_row_max_cppl(const NumericVector &slot_x,
+                               const IntegerVector &slot_i,
+                               const IntegerVector &slot_p,
+                               const int n_rows,
+                               const int thread){
+
+    int n_cols = slot_p.size() - 1;
+    std::size_t n_cells = slot_x.size();
+    const double *x = REAL(slot_x);
+    const int *rows = INTEGER(slot_i);
+    const int *ptrs = INTEGER(slot_p);
+    for (std::size_t k = 0; k < n_cells; k++) {
+        if (rows[k] < 0 || rows[k] >= n_rows) stop("Invalid row index of a dfm");
+    }
+    const double lowest = -std::numeric_limits<double>::infinity();
+    std::vector<double> maxs(n_rows, lowest);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<double> maxs_local(n_rows, lowest);
+        #ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 256)
+        #endif
+        for (int j = 0; j < n_cols; j++) {
+            for (int k = ptrs[j]; k < ptrs[j + 1]; k++) {
+                maxs_local[rows[k]] = std::max(maxs_local[rows[k]], x[k]);
+            }
+        }
+        #ifdef _OPENMP
+        #pragma omp critical
+        #endif
+        for (int i = 0; i < n_rows; i++) maxs[i] = std::max(maxs[i], maxs_local[i]);
+    }
+    // Empty cells are zeros, as in a dense matrix
+    std::vector<int> counts(n_rows, 0);
+    for (std::size_t k = 0; k < n_cells; k++) counts[rows[k]]++;
+    NumericVector result(n_rows);
+    for (int i = 0; i < n_rows; i++) {
+        result[i] = counts[i] < n_cols ? std::max(maxs[i], 0.0) : maxs[i];
+    }
+    return result;
+}
+
+// Number of documents in which each feature is counted more than threshold
+// [[Rcpp::export]]
+IntegerVector dfm_docfreq_cppl(const NumericVector &slot_x,
+                               const IntegerVector &slot_p,
+                               const double threshold,
+                               const int thread){
+
+    int n_cols = slot_p.size() - 1;
+    const double *x = REAL(slot_x);
+    const int *ptrs = INTEGER(slot_p);
+    IntegerVector result(n_cols);
+    int *counts = INTEGER(result);
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(thread) schedule(dynamic, 256)
+    #endif
+    for (int j = 0; j < n_cols; j++) {
+        int n = 0;
+        for (int k = ptrs[j]; k < ptrs[j + 1]; k++) n += x[k] > threshold;
+        counts[j] = n;
+    }
+    return result;
+}
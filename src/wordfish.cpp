@@ -1,221 +1,369 @@
 
 // includes from the plugin
 #include <RcppArmadillo.h>
+#include <random>
+#include "residuals.h"
+#include "profile.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace Rcpp;
 
 // [[Rcpp::depends(RcppArmadillo)]]
 
-// [[Rcpp::export]]
+// Tight loop over a contiguous buffer, left for the compiler to vectorize
+inline void exp_inplace(double *v, const int n){
+    for (int j = 0; j < n; j++) v[j] = std::exp(v[j]);
+}
+
+// Set mean to 0 and standard deviation to 1
+void standardize(std::vector<double> &v){
+    double m = 0.0, s = 0.0;
+    for (std::size_t j = 0; j < v.size(); j++) m += v[j];
+    m /= v.size();
+    for (std::size_t j = 0; j < v.size(); j++) s += (v[j] - m) * (v[j] - m);
+    s = std::sqrt(s / (v.size() - 1));
+    for (std::size_t j = 0; j < v.size(); j++) v[j] = (v[j] - m) / s;
+}
+
+// One Newton-Raphson step for a pair of parameters, returning the largest change
+inline double newton_step(double &par0, double &par1,
+                          const double G0, const double G1,
+                          const double H00, const double H01, const double H11,
+                          const double stepsize){
+    double det = H00 * H11 - H01 * H01;
+    double d0 = stepsize * (H11 * G0 - H01 * G1) / det;
+    double d1 = stepsize * (H00 * G1 - H01 * G0) / det;
+    par0 -= d0;
+    par1 -= d1;
+    return std::max(std::fabs(d0), std::fabs(d1));
+}
+
+// Sum of the log-likelihood over documents: the data term only involves the
+// non-zero counts, while the expected counts are summed over all cells, one
+// document at a time
+double loglik(const SparseCounts &Y,
+              const std::vector<double> &alpha, const std::vector<double> &psi,
+              const std::vector<double> &beta, const std::vector<double> &theta,
+              const int thread){
+
+    std::vector<double> ll_docs(Y.N);
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<double> buf(Y.K);
+        #ifdef _OPENMP
+        #pragma omp for schedule(static)
+        #endif
+        for (int i = 0; i < Y.N; i++) {
+            for (int k = 0; k < Y.K; k++) buf[k] = psi[k] + beta[k] * theta[i];
+            exp_inplace(buf.data(), Y.K);
+            double mu = 0.0;
+            for (int k = 0; k < Y.K; k++) mu += buf[k];
+            double ll = -std::exp(alpha[i]) * mu;
+            for (int j = Y.row_p[i]; j < Y.row_p[i + 1]; j++) {
+                int k = Y.row_k[j];
+                ll += Y.row_x[j] * (alpha[i] + psi[k] + beta[k] * theta[i]);
+            }
+            ll_docs[i] = ll;
+        }
+    }
+    double ll = 0.0;
+    for (int i = 0; i < Y.N; i++) ll += ll_docs[i]; // summed in order to be reproducible
+    return ll;
+}
+
+double logposterior(const SparseCounts &Y,
+                    const std::vector<double> &alpha, const std::vector<double> &psi,
+                    const std::vector<double> &beta, const std::vector<double> &theta,
+                    const std::vector<double> &prec, const int thread){
+    double lp = 0.0;
+    for (int i = 0; i < Y.N; i++)
+        lp -= 0.5 * (alpha[i] * alpha[i] * prec[0] + theta[i] * theta[i] * prec[3]);
+    for (int k = 0; k < Y.K; k++)
+        lp -= 0.5 * (psi[k] * psi[k] * prec[1] + beta[k] * beta[k] * prec[2]);
+    return lp + loglik(Y, alpha, psi, beta, theta, thread);
+}
+
+// Estimate the parameters by conditional maximum likelihood from their starting
+// values. Words are independent of each other given the document parameters,
+// and documents given the word parameters, so both are updated in parallel.
+// Returns the number of outer iterations.
+int wordfish_fit(const SparseCounts &Y,
+                  std::vector<double> &alpha, std::vector<double> &psi,
+                  std::vector<double> &beta, std::vector<double> &theta,
+                  std::vector<double> &phi, std::vector<double> &thetaSE,
+                  const std::vector<double> &prec, const std::vector<double> &tol,
+                  const int disptype, const double dispmin, const int thread){
+
+    const int N = Y.N;
+    const int K = Y.K;
+    std::vector<double> invphi(K, 1.0);
+    std::vector<double> disp_words(K);
+    int outeriter = 0;
+
+    double lastlp = -2000000000000.0;
+    double lp = logposterior(Y, alpha, psi, beta, theta, prec, thread);
+
+    while (((lp - lastlp) > tol[0]) && outeriter < 100) {
+        outeriter++;
+        double stepsize_first = (outeriter == 1) ? 0.5 : 1.0;
+
+        // UPDATE WORD PARAMETERS
+        #ifdef _OPENMP
+        #pragma omp parallel num_threads(thread)
+        #endif
+        {
+            std::vector<double> buf(N);
+            #ifdef _OPENMP
+            #pragma omp for schedule(dynamic, 64)
+            #endif
+            for (int k = 0; k < K; k++) {
+                double ytheta = 0.0;
+                for (int j = Y.col_p[k]; j < Y.col_p[k + 1]; j++)
+                    ytheta += theta[Y.col_i[j]] * Y.col_x[j];
+                double cc = 1.0, stepsize = stepsize_first;
+                int inneriter = 0;
+                while ((cc > tol[1]) && inneriter < 10) {
+                    inneriter++;
+                    for (int i = 0; i < N; i++) buf[i] = alpha[i] + psi[k] + beta[k] * theta[i];
+                    exp_inplace(buf.data(), N);
+                    double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+                    for (int i = 0; i < N; i++) {
+                        s0 += buf[i];
+                        s1 += theta[i] * buf[i];
+                        s2 += theta[i] * theta[i] * buf[i];
+                    }
+                    cc = newton_step(psi[k], beta[k],
+                                     (Y.csum[k] - s0) / phi[k] - psi[k] * prec[1],
+                                     (ytheta - s1) / phi[k] - beta[k] * prec[2],
+                                     -s0 / phi[k] - prec[1], -s1 / phi[k], -s2 / phi[k] - prec[2],
+                                     stepsize);
+                    stepsize = 1.0;
+                }
+            }
+        }
+
+        // UPDATE DOCUMENT PARAMETERS
+        for (int k = 0; k < K; k++) invphi[k] = 1.0 / phi[k];
+        #ifdef _OPENMP
+        #pragma omp parallel num_threads(thread)
+        #endif
+        {
+            std::vector<double> buf(K);
+            #ifdef _OPENMP
+            #pragma omp for schedule(dynamic, 16)
+            #endif
+            for (int i = 0; i < N; i++) {
+                double yphi = 0.0, ybeta = 0.0;
+                for (int j = Y.row_p[i]; j < Y.row_p[i + 1]; j++) {
+                    int k = Y.row_k[j];
+                    yphi += Y.row_x[j] * invphi[k];
+                    ybeta += beta[k] * Y.row_x[j] * invphi[k];
+                }
+                double cc = 1.0, stepsize = stepsize_first;
+                int inneriter = 0;
+                while ((cc > tol[1]) && inneriter < 10) {
+                    inneriter++;
+                    for (int k = 0; k < K; k++) buf[k] = alpha[i] + psi[k] + beta[k] * theta[i];
+                    exp_inplace(buf.data(), K);
+                    double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+                    for (int k = 0; k < K; k++) {
+                        double l = buf[k] * invphi[k];
+                        s0 += l;
+                        s1 += beta[k] * l;
+                        s2 += beta[k] * beta[k] * l;
+                    }
+                    cc = newton_step(alpha[i], theta[i],
+                                     yphi - s0 - alpha[i] * prec[0],
+                                     ybeta - s1 - theta[i] * prec[3],
+                                     -s0 - prec[0], -s1, -s2 - prec[3],
+                                     stepsize);
+                    stepsize = 1.0;
+                }
+            }
+        }
+
+        // UPDATE DISPERSION PARAMETERS
+        // (y - mu)^2 / mu is y^2 / mu - 2y + mu, so only the sum of mu is dense
+        if (disptype >= 2) {
+            #ifdef _OPENMP
+            #pragma omp parallel num_threads(thread)
+            #endif
+            {
+                std::vector<double> buf(N);
+                #ifdef _OPENMP
+                #pragma omp for schedule(dynamic, 64)
+                #endif
+                for (int k = 0; k < K; k++) {
+                    for (int i = 0; i < N; i++) buf[i] = alpha[i] + psi[k] + beta[k] * theta[i];
+                    exp_inplace(buf.data(), N);
+                    double d = 0.0;
+                    for (int i = 0; i < N; i++) d += buf[i];
+                    for (int j = Y.col_p[k]; j < Y.col_p[k + 1]; j++) {
+                        double y = Y.col_x[j];
+                        d += y * y / buf[Y.col_i[j]] - 2 * y;
+                    }
+                    disp_words[k] = d;
+                }
+            }
+            double df = (double)N * K - 2 * N - 2 * K;
+            if (disptype == 2) { // single dispersion parameter for all words
+                double phitmp = 0.0;
+                for (int k = 0; k < K; k++) phitmp += disp_words[k];
+                phitmp = phitmp / df;
+                for (int k = 0; k < K; k++) phi[k] = phitmp;
+            } else { // individual dispersion parameter for each word
+                for (int k = 0; k < K; k++) {
+                    phi[k] = (K * disp_words[k]) / df;
+                    // set ceiling on underdispersion
+                    if (disptype == 4) phi[k] = std::max(dispmin, phi[k]);
+                }
+            }
+        }
 
-Rcpp::List wordfishcpp(SEXP wfm, SEXP dir, SEXP priors, SEXP tol, SEXP disp, SEXP dispfloor){
-
-	// DEFINE INPUTS
-	
-		Rcpp::NumericMatrix Y(wfm); 
-		Rcpp::NumericVector priorvec(priors);
-		Rcpp::NumericVector tolvec(tol); 
-  	    Rcpp::IntegerVector dirvec(dir);  
-  	    Rcpp::IntegerVector disptype(disp);
-  	    Rcpp::NumericVector dispmin(dispfloor);
-		
-		double priorprecalpha = priorvec(0);
-		double priorprecpsi = priorvec(1);
-		double priorprecbeta = priorvec(2);
-		double priorprectheta = priorvec(3);		
-		
-		int N = Y.nrow();
-		int K = Y.ncol();
-
-	// SET INITIAL VALUES
-	
-		Rcpp::NumericVector alpha(N); 
-		Rcpp::NumericVector psi(K); 
-		Rcpp::NumericVector beta(K); 
-		Rcpp::NumericVector theta(N); 
-		
-		Rcpp::NumericVector thetaSE(N); // document position standard errors
-		Rcpp::NumericVector phi(K,1.0); // word-level dispersion parameters
-		
-		// Construct Chi-Sq Residuals	
-		arma::mat C(Y.begin(),N,K); 
-		arma::colvec rsum = sum(C,1);
-		arma::rowvec csum = sum(C,0);
-		double asum = sum(rsum);		
-		for (int i=0; i < N; i++){
-			for (int k=0; k < K; k++){
-				C(i,k) = (Y(i,k) - rsum(i)*csum(k)/asum)/sqrt(rsum(i)*csum(k)/asum);	
-			}
-		}
-		
-		// Singular Value Decomposition of Chi-Sq Residuals
-		arma::mat U(N,N);
-		arma::vec s(N);
-		arma::mat V(K,N);
-		svd(U,s,V,C);
-	
-		// Load initial values
-		for (int i=0; i < N; i++) theta(i) = pow(rsum(i)/asum,-0.5) * U(i,0);
-		for (int k=0; k < K; k++) beta(k) = 0; // pow(csum(k)/asum,-0.5) * V(k,0);
-		for (int i=0; i < N; i++) alpha = log(rsum);
-		psi = log(csum/N);
-		
-		alpha = alpha - log(mean(rsum));
-		theta = (theta - mean(theta))/sd(theta);  
-		
-		// Create temporary variables
-		Rcpp::NumericMatrix pars(2,1);
-		Rcpp::NumericMatrix newpars(2,1);		
-		Rcpp::NumericMatrix G(2,1);
-		Rcpp::NumericMatrix H(2,2);
-		double loglambdaik;
-		double mutmp;		
-		double phitmp;
-		Rcpp::NumericVector lambdai(K);
-		Rcpp::NumericVector lambdak(N);
-		double stepsize = 1.0;
-		double cc = 0.0;
-		int inneriter = 0;
-		int outeriter = 0;
-		
-		double lastlp = -2000000000000.0;
-		double lp = -1.0*(sum(0.5 * ((alpha*alpha)*(priorprecalpha))) + sum(0.5 * ((psi*psi)*(priorprecpsi))) + sum(0.5 * ((beta*beta)*(priorprecbeta))) + sum(0.5 * ((theta*theta)*(priorprectheta))));
-			for (int i=0; i < N; i++){
-				for (int k=0; k < K; k++){
-					loglambdaik = alpha(i) + psi(k) + beta(k)*theta(i);
-					lp = lp + loglambdaik*Y(i,k)-exp(loglambdaik);
-				}
-			}
-	
-	// BEGIN WHILE LOOP
-	while(((lp - lastlp) > tolvec(0)) && outeriter < 100){	
-		outeriter++;
-	  	
-		// UPDATE WORD PARAMETERS
-			for (int k=0; k < K; k++){
-				cc = 1;
-				inneriter = 0;
-				if (outeriter == 1) stepsize = 0.5;
-				while ((cc > tolvec(1)) && inneriter < 10){
-					inneriter++;
-					lambdak = exp(alpha + psi(k) + beta(k)*theta);
-					G(0,0) = sum(Y(_,k) - lambdak)/phi(k) - psi(k)*(priorprecpsi);
-					G(1,0) = sum(theta*(Y(_,k) - lambdak))/phi(k) - beta(k)*(priorprecbeta);
-					H(0,0) = -sum(lambdak)/phi(k) - priorprecpsi;
-					H(1,0) = -sum(theta*lambdak)/phi(k);
-					H(0,1) = H(1,0);
-					H(1,1) = -sum((theta*theta)*lambdak)/phi(k) - priorprecbeta;
-					pars(0,0) = psi(k);
-					pars(1,0) = beta(k);
-					newpars(0,0) = pars(0,0) - stepsize*(H(1,1)*G(0,0) - H(0,1)*G(1,0))/(H(0,0)*H(1,1) - H(0,1)*H(1,0));
-					newpars(1,0) = pars(1,0) - stepsize*(H(0,0)*G(1,0) - H(1,0)*G(0,0))/(H(0,0)*H(1,1) - H(0,1)*H(1,0));
-					psi(k) = newpars(0,0);
-					beta(k) = newpars(1,0);
-					cc = max(abs(newpars - pars));
-					stepsize = 1.0;
-				}	
-			}	
-
-		
-		// UPDATE DOCUMENT PARAMETERS
-			for (int i=0; i < N; i++){
-				cc = 1;
-				inneriter = 0;
-				if (outeriter == 1) stepsize = 0.5;
-				while ((cc > tolvec(1)) && inneriter < 10){
-					inneriter++;
-					lambdai = exp(alpha(i) + psi + beta*theta(i));
-					G(0,0) = sum((Y(i,_) - lambdai)/phi) - alpha(i)*priorprecalpha;
-					G(1,0) = sum((beta*(Y(i,_) - lambdai))/phi) - theta(i)*priorprectheta;		
-					H(0,0) = -sum(lambdai/phi) - priorprecalpha;
-					H(1,0) = -sum((beta*lambdai)/phi);
-					H(0,1) = H(1,0);
-					H(1,1) = -sum(((beta* beta)*lambdai)/phi) - priorprectheta;
-					pars(0,0) = alpha(i);
-					pars(1,0) = theta(i);
-					newpars(0,0) = pars(0,0) - stepsize*(H(1,1)*G(0,0) - H(0,1)*G(1,0))/(H(0,0)*H(1,1) - H(0,1)*H(1,0));
-					newpars(1,0) = pars(1,0) - stepsize*(H(0,0)*G(1,0) - H(1,0)*G(0,0))/(H(0,0)*H(1,1) - H(0,1)*H(1,0));
-					alpha(i) = newpars(0,0);
-					theta(i) = newpars(1,0);
-					cc = max(abs(newpars - pars));	
-					stepsize = 1.0;
-				}	
-			}
-			
-			// UPDATE DISPERSION PARAMETERS	  
-			
-			if (disptype(0) == 2) { // single dispersion parameter for all words
-			  phitmp = 0.0;
-			  for (int k=0; k < K; k++){
-			    for (int i=0; i < N; i++){
-			      mutmp = exp(alpha(i) + psi(k) + beta(k)*theta(i));
-			      phitmp = phitmp + (Y(i,k) - mutmp)*(Y(i,k) - mutmp)/mutmp;
-			    }   
-			  }	    
-			  phitmp = phitmp/(N*K - 2*N - 2*K);
-			  for (int k=0; k < K; k++) phi(k) = phitmp;
-			}
-			
-			if (disptype(0) >= 3) { // individual dispersion parameter for each word
-			  for (int k=0; k < K; k++){
-			    phitmp = 0.0;
-			    for (int i=0; i < N; i++){
-			      mutmp = exp(alpha(i) + psi(k) + beta(k)*theta(i));
-			      phitmp = phitmp + (Y(i,k) - mutmp)*(Y(i,k) - mutmp)/mutmp;	        
-			    }   
-			    phitmp = ((K)*phitmp)/(N*K - 2*N - 2*K);
-			    phi(k) = phitmp;
-			    // set ceiling on underdispersion
-			    if (disptype(0) == 4) phi(k) = fmax(dispmin(0), phi(k));
-			  }
-			}	  			
-		
-		alpha = alpha - mean(alpha);
-		theta = (theta - mean(theta))/sd(theta);		
-		
-		// CHECK LOG-POSTERIOR FOR CONVERGENCE
-			lastlp = lp;
-			lp = -1.0*(sum(0.5 * ((alpha*alpha)*(priorprecalpha))) + sum(0.5 * ((psi*psi)*(priorprecpsi))) + sum(0.5 * ((beta*beta)*(priorprecbeta))) + sum(0.5 * ((theta*theta)*(priorprectheta))));
-			for (int i=0; i < N; i++){
-				for (int k=0; k < K; k++){
-					loglambdaik = alpha(i) + psi(k) + beta(k)*theta(i);
-					lp = lp + loglambdaik*Y(i,k)-exp(loglambdaik);
-				}
-			}
-			// Rprintf("%d: %f2\\n",outeriter,lp);
-
-	// END WHILE LOOP		
-	} 
-  
-      
-  // Fix Global Polarity  
-  
-  // added the -1 because C counts from ZERO...  -- KB
-  if (theta(dirvec(0)-1) > theta(dirvec(1)-1)) {
-    beta = -beta;
-    theta = -theta;
-  }
-  
-  // COMPUTE DOCUMENT STANDARD ERRORS
-  for (int i=0; i < N; i++) {
-    lambdai = exp(alpha(i) + psi + beta*theta(i));
-    H(0,0) = -sum(lambdai/phi) - priorprecalpha;
-    H(1,0) = -sum((beta*lambdai)/phi);
-    H(0,1) = H(1,0);
-    H(1,1) = -sum(((beta* beta)*lambdai)/phi) - priorprectheta;
-    thetaSE(i) = sqrt(-1.0*H(0,0)/(H(0,0)*H(1,1)-H(1,0)*H(0,1)));
-  }  
-		
-	// DEFINE OUTPUT	
-	
-	return Rcpp::List::create(Rcpp::Named("theta") = theta,
-                          Rcpp::Named("alpha") = alpha,
-                          Rcpp::Named("psi") = psi,
-                          Rcpp::Named("beta") = beta,
-                          Rcpp::Named("phi") = phi,
-                          Rcpp::Named("thetaSE") = thetaSE);
+        double malpha = 0.0;
+        for (int i = 0; i < N; i++) malpha += alpha[i];
+        malpha /= N;
+        for (int i = 0; i < N; i++) alpha[i] -= malpha;
+        standardize(theta);
 
+        // CHECK LOG-POSTERIOR FOR CONVERGENCE
+        lastlp = lp;
+        lp = logposterior(Y, alpha, psi, beta, theta, prec, thread);
+    }
+
+    // COMPUTE DOCUMENT STANDARD ERRORS
+    for (int k = 0; k < K; k++) invphi[k] = 1.0 / phi[k];
+    #ifdef _OPENMP
+    #pragma omp parallel num_threads(thread)
+    #endif
+    {
+        std::vector<double> buf(K);
+        #ifdef _OPENMP
+        #pragma omp for schedule(static)
+        #endif
+        for (int i = 0; i < N; i++) {
+            for (int k = 0; k < K; k++) buf[k] = alpha[i] + psi[k] + beta[k] * theta[i];
+            exp_inplace(buf.data(), K);
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0;
+            for (int k = 0; k < K; k++) {
+                double l = buf[k] * invphi[k];
+                s0 += l;
+                s1 += beta[k] * l;
+                s2 += beta[k] * beta[k] * l;
+            }
+            double H00 = -s0 - prec[0];
+            double H11 = -s2 - prec[3];
+            thetaSE[i] = std::sqrt(-1.0 * H00 / (H00 * H11 - s1 * s1));
+        }
+    }
+    return outeriter;
+}
+
+// Leading left singular vector of the residual matrix by randomized subspace
+// iteration on a small block of vectors, iterated until the vector converges
+// or for max_iter iterations, whose number is set in iterations.
+// The random start is drawn from a fixed seed, not from R's generator.
+arma::vec leading_left_singular(const ResidualMatrix &C, const int N, const int K,
+                                const double tol, const int max_iter, int &iterations){
+
+    int l = std::min(std::min(N, K), 10);
+    std::mt19937 gen(5489u);
+    arma::mat Omega(K, l);
+    for (int k = 0; k < K; k++) {
+        for (int j = 0; j < l; j++) Omega(k, j) = 2.0 * gen() / gen.max() - 1.0;
+    }
+
+    arma::mat Q, R, Z, Ub, Vb;
+    arma::vec s, u, u_last;
+    arma::qr_econ(Q, R, C.times(Omega));
+    iterations = 0;
+    while (iterations++ < max_iter) {
+        Z = C.trans_times(Q); // B = Q' C = Z'
+        arma::svd_econ(Ub, s, Vb, arma::mat(arma::trans(Z)));
+        u = Q * Ub.col(0);
+        if (iterations > 1 && 1.0 - std::fabs(arma::dot(u, u_last)) < tol) break;
+        u_last = u;
+        arma::qr_econ(Q, R, Z);
+        arma::qr_econ(Q, R, C.times(Q));
+    }
+    iterations = std::min(iterations, max_iter);
+    return u;
+}
+
+// Leading left singular vector of the residual matrix of the slots of a
+// dgCMatrix, with the number of iterations taken; for testing
+// [[Rcpp::export]]
+Rcpp::List leading_left_singular_cppl(const IntegerVector &slot_i, const IntegerVector &slot_p,
+                                      const NumericVector &slot_x, const int N, const int K,
+                                      const double tol, const int max_iter){
+
+    if (max_iter < 1) stop("Invalid number of iterations");
+    SparseCounts Y = sparse_counts(slot_i, slot_p, slot_x, N, K);
+    int iterations;
+    arma::vec u = leading_left_singular(ResidualMatrix(Y, 1), N, K, tol, max_iter, iterations);
+    return Rcpp::List::create(Rcpp::Named("u") = Rcpp::wrap(arma::conv_to< std::vector<double> >::from(u)),
+                              Rcpp::Named("iterations") = iterations);
 }
 
+// Fit wordfish to the slots of a dgCMatrix of N documents and K features
+// [[Rcpp::export]]
+Rcpp::List wordfishcpp(const IntegerVector &slot_i, const IntegerVector &slot_p,
+                       const NumericVector &slot_x, const int N, const int K,
+                       const IntegerVector &dir, const std::vector<double> &priors,
+                       const std::vector<double> &tol, const int disp,
+                       const double dispfloor, const int thread){
+
+    PROFILE_CALL("wordfishcpp");
+    PROFILE_STAGE("initialize");
+    SparseCounts Y = sparse_counts(slot_i, slot_p, slot_x, N, K);
+
+    // SET INITIAL VALUES
+
+    std::vector<double> alpha(N), psi(K), beta(K, 0.0), theta(N);
+    std::vector<double> thetaSE(N); // document position standard errors
+    std::vector<double> phi(K, 1.0); // word-level dispersion parameters
+
+    // Leading singular vector of the Chi-Sq Residuals
+    double asum = 0.0;
+    for (int i = 0; i < N; i++) asum += Y.rsum[i];
+    int iterations_svd;
+    arma::vec u = leading_left_singular(ResidualMatrix(Y, thread), N, K, 1e-12, 100, iterations_svd);
 
+    // Load initial values
+    double mrsum = asum / N;
+    for (int i = 0; i < N; i++) {
+        theta[i] = std::pow(Y.rsum[i] / asum, -0.5) * u(i);
+        alpha[i] = std::log(Y.rsum[i]) - std::log(mrsum);
+    }
+    for (int k = 0; k < K; k++) psi[k] = std::log(Y.csum[k] / N);
+    standardize(theta);
 
+    PROFILE_COUNT("documents", N);
+    PROFILE_COUNT("features", K);
+    PROFILE_COUNT("nonzero", slot_x.size());
+    PROFILE_COUNT("iterations_svd", iterations_svd);
+
+    PROFILE_STAGE("fit");
+    int iterations = wordfish_fit(Y, alpha, psi, beta, theta, phi, thetaSE, priors, tol,
+                                  disp, dispfloor, thread);
+    PROFILE_COUNT("iterations", iterations);
+
+    // Fix Global Polarity
+    // added the -1 because C counts from ZERO...  -- KB
+    if (theta[dir[0] - 1] > theta[dir[1] - 1]) {
+        for (int k = 0; k < K; k++) beta[k] = -beta[k];
+        for (int i = 0; i < N; i++) theta[i] = -theta[i];
+    }
+
+    // DEFINE OUTPUT
+    return Rcpp::List::create(Rcpp::Named("theta") = Rcpp::wrap(theta),
+                              Rcpp::Named("alpha") = Rcpp::wrap(alpha),
+                              Rcpp::Named("psi") = Rcpp::wrap(psi),
+                              Rcpp::Named("beta") = Rcpp::wrap(beta),
+                              Rcpp::Named("phi") = Rcpp::wrap(phi),
+                              Rcpp::Named("thetaSE") = Rcpp::wrap(thetaSE));
+}